@@ -0,0 +1,165 @@
+/**
+ * @file      bench_cache.cpp
+ * @brief     Cache::PerformOperation benchmarks for several access patterns and geometries.
+ *            Requests go to a counting sink so that only the cache itself is measured.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <benchmark.h>
+
+#include <core/cache_model.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+    struct Geometry
+    {
+        // Geometry label.
+        char const* m_label;
+
+        // Amount of sets.
+        std::size_t m_sets;
+
+        // Amount of ways.
+        std::size_t m_ways;
+
+        // Line size in bytes (block size of sectored caches).
+        std::size_t m_line_size;
+
+        // Sector size in bytes. Zero for a set-associative cache.
+        std::size_t m_sector_size;
+    };
+
+    enum class Pattern
+    {
+        // Uniform random accesses over half of the capacity, pre-warmed.
+        HIT_HEAVY,
+
+        // Uniform random accesses over 64x the capacity.
+        MISS_HEAVY,
+
+        // Cyclic sweep over 1.25x the capacity.
+        THRASHING
+    };
+
+    char const* PatternName(Pattern pattern)
+    {
+        switch (pattern)
+        {
+            case Pattern::HIT_HEAVY:  return "hit_heavy";
+            case Pattern::MISS_HEAVY: return "miss_heavy";
+            case Pattern::THRASHING:  return "thrashing";
+        }
+
+        return "unknown";
+    }
+
+    // Build the access stream for a pattern. 30% of the accesses are stores.
+    std::vector<MemoryAccess> BuildAccesses(Pattern pattern, Geometry const& geometry, std::size_t count)
+    {
+        std::size_t const capacity_lines = geometry.m_sets * geometry.m_ways;
+        address_t const base = 0x10000000;
+
+        std::size_t footprint_lines = capacity_lines / 2;
+        if (pattern == Pattern::MISS_HEAVY)
+            footprint_lines = capacity_lines * 64;
+        else if (pattern == Pattern::THRASHING)
+            footprint_lines = capacity_lines + capacity_lines / 4;
+
+        footprint_lines = std::max<std::size_t>(1, footprint_lines);
+
+        SplitMix64 random(static_cast<std::uint64_t>(pattern) * 1000003 + capacity_lines);
+        std::vector<MemoryAccess> accesses(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t const line = (pattern == Pattern::THRASHING) ? (i % footprint_lines) : (random.Next() % footprint_lines);
+
+            accesses[i].m_operation = (random.Next() % 10 < 3) ? STORE : LOAD;
+            accesses[i].m_address = base + line * geometry.m_line_size + (random.Next() % geometry.m_line_size);
+        }
+
+        return accesses;
+    }
+
+    void RegisterPattern(BenchmarkRegistry& registry, BenchmarkSettings const& settings, Geometry const& geometry, Pattern pattern)
+    {
+        std::size_t const count = settings.Scaled(2000000);
+
+        auto accesses = std::make_shared<std::vector<MemoryAccess>>();
+        auto cache = std::make_shared<std::unique_ptr<CacheModel>>();
+        auto sink = std::make_shared<CountingSink>();
+
+        Benchmark benchmark;
+        benchmark.m_name = std::string("cache/") + PatternName(pattern) + "/" + geometry.m_label;
+        benchmark.m_parameters = {
+            {"pattern", PatternName(pattern)},
+            {"sets", std::to_string(geometry.m_sets)},
+            {"ways", std::to_string(geometry.m_ways)},
+            {"line_size", std::to_string(geometry.m_line_size)},
+            {"sector_size", std::to_string(geometry.m_sector_size)},
+            {"accesses", std::to_string(count)}
+        };
+
+        benchmark.m_setup = [=]()
+        {
+            *accesses = BuildAccesses(pattern, geometry, count);
+
+            Config config{};
+            config.m_sets = geometry.m_sets;
+            config.m_ways = geometry.m_ways;
+            config.m_line_size = geometry.m_line_size;
+
+            if (geometry.m_sector_size != 0)
+            {
+                config.m_organization = CacheOrganization::SECTORED;
+                config.m_sector_size = geometry.m_sector_size;
+            }
+
+            *cache = CreateCacheModel(config, *sink);
+
+            // Warm the cache so that the timed repetitions observe the steady state.
+            (*cache)->PerformOperations(accesses->data(), accesses->size());
+        };
+
+        benchmark.m_run = [=]()
+        {
+            (*cache)->PerformOperations(accesses->data(), accesses->size());
+
+            return BenchmarkWork{accesses->size(), 0};
+        };
+
+        benchmark.m_teardown = [=]()
+        {
+            cache->reset();
+            accesses->clear();
+        };
+
+        registry.Add(std::move(benchmark));
+    }
+}
+
+void RegisterCacheBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings)
+{
+    Geometry const geometries[] = {
+        {"32KiB_64x8",              64,    8,     64,   0},
+        {"1MiB_1024x16",            1024,  16,    64,   0},
+        {"16MiB_32768x8",           32768, 8,     64,   0},
+        {"256KiB_16x256",           16,    256,   64,   0},
+        {"64KiB_1x1024",            1,     1024,  64,   0},
+        {"1MiB_1x16384",            1,     16384, 64,   0},
+        {"1GiB_sectored_16384x16",  16384, 16,    4096, 64}
+    };
+
+    for (Pattern pattern : {Pattern::HIT_HEAVY, Pattern::MISS_HEAVY, Pattern::THRASHING})
+        for (Geometry const& geometry : geometries)
+            RegisterPattern(registry, settings, geometry, pattern);
+}
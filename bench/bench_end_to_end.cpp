@@ -0,0 +1,113 @@
+/**
+ * @file      bench_end_to_end.cpp
+ * @brief     End-to-end benchmarks: TraceReader, Cache and TraceEngine over traces from the trace generator.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <benchmark.h>
+
+#include <core/cache.h>
+#include <utils/trace_engine.h>
+#include <utils/trace_generator.h>
+#include <utils/trace_reader.h>
+
+#include <filesystem>
+#include <memory>
+
+namespace
+{
+    struct Workload
+    {
+        // Workload label.
+        char const* m_label;
+
+        // Generator phases.
+        std::vector<GeneratorPhase> m_phases;
+
+        // Bytes touched by the workload.
+        std::uint64_t m_footprint;
+    };
+}
+
+void RegisterEndToEndBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings)
+{
+    std::size_t const count = settings.Scaled(2000000);
+
+    // Workloads produced by the trace generator. The cache holds 16 MiB.
+    Workload const workloads[] = {
+        {"zipfian",   {{AccessPattern::ZIPFIAN, count}},                                     64ull << 20},
+        {"streaming", {{AccessPattern::STREAMING, count}},                                   1ull << 30},
+        {"random",    {{AccessPattern::RANDOM, count}},                                      1ull << 30},
+        {"mixed",     {{AccessPattern::ZIPFIAN, 100000}, {AccessPattern::STREAMING, 50000},
+                       {AccessPattern::POINTER_CHASE, 50000}},                               64ull << 20}
+    };
+
+    for (Workload const& workload : workloads)
+    {
+        std::string const path = (std::filesystem::path(settings.m_scratch_directory) / (std::string("e2e_") + workload.m_label + ".trace")).string();
+        auto file_size = std::make_shared<std::uint64_t>(0);
+
+        Benchmark benchmark;
+        benchmark.m_name = std::string("end_to_end/") + workload.m_label;
+        benchmark.m_parameters = {
+            {"workload", workload.m_label},
+            {"accesses", std::to_string(count)},
+            {"footprint", std::to_string(workload.m_footprint)},
+            {"sets", "32768"},
+            {"ways", "8"},
+            {"line_size", "64"}
+        };
+
+        GeneratorConfig config;
+        config.m_phases = workload.m_phases;
+        config.m_accesses = count;
+        config.m_footprint = workload.m_footprint;
+
+        benchmark.m_setup = [=]()
+        {
+            *file_size = TraceGenerator(config).Write(path);
+        };
+
+        std::string const sink_file = settings.m_sink_file;
+
+        benchmark.m_run = [=]()
+        {
+            // Same flow as main.cpp, including the cache construction and final flush.
+            std::unique_ptr<TraceEngine> engine;
+            {
+                QuietScope quiet;
+                engine = std::make_unique<TraceEngine>(sink_file);
+            }
+
+            TraceReader reader(path);
+            auto cache = std::make_unique<Cache>(32768, 8, 64, *engine);
+
+            Operation operation;
+            address_t address;
+            std::uint64_t accesses = 0;
+
+            while (reader.GetNextAccess(operation, address))
+            {
+                cache->PerformOperation(operation, address);
+                ++accesses;
+            }
+
+            cache->Flush();
+            engine->Shutdown();
+            return BenchmarkWork{accesses, *file_size};
+        };
+
+        benchmark.m_teardown = [=]()
+        {
+            std::filesystem::remove(path);
+        };
+
+        registry.Add(std::move(benchmark));
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file      bench_trace_engine.cpp
+ * @brief     TraceEngine write throughput benchmarks.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <benchmark.h>
+
+#include <utils/trace_engine.h>
+
+#include <memory>
+
+namespace
+{
+    // Length of a formatted "LD 0x<hex>\n" record.
+    std::uint64_t RecordBytes(address_t address)
+    {
+        std::uint64_t digits = 1;
+        while (address >>= 4)
+            ++digits;
+
+        return 6 + digits;
+    }
+}
+
+void RegisterTraceEngineBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings)
+{
+    std::size_t const count = settings.Scaled(1000000);
+    auto addresses = std::make_shared<std::vector<address_t>>();
+    auto bytes = std::make_shared<std::uint64_t>(0);
+
+    Benchmark benchmark;
+    benchmark.m_name = "engine/write/mixed";
+    benchmark.m_parameters = {{"requests", std::to_string(count)}, {"sink", settings.m_sink_file}};
+
+    benchmark.m_setup = [=]()
+    {
+        // Line-aligned 48-bit addresses.
+        SplitMix64 random(42);
+        addresses->resize(count);
+        *bytes = 0;
+
+        for (address_t& address : *addresses)
+        {
+            address = (random.Next() & 0xFFFFFFFFFFC0ull) | 0x800000000000ull;
+            *bytes += RecordBytes(address);
+        }
+    };
+
+    std::string const sink_file = settings.m_sink_file;
+
+    benchmark.m_run = [=]()
+    {
+        std::unique_ptr<TraceEngine> engine;
+        {
+            QuietScope quiet;
+            engine = std::make_unique<TraceEngine>(sink_file);
+        }
+
+        // Alternate loads and stores.
+        for (std::size_t i = 0; i < addresses->size(); ++i)
+        {
+            if (i & 1)
+                engine->Store((*addresses)[i], i);
+            else
+                engine->Load((*addresses)[i], i);
+        }
+
+        engine->Shutdown();
+
+        return BenchmarkWork{addresses->size(), *bytes};
+    };
+
+    benchmark.m_teardown = [=]()
+    {
+        addresses->clear();
+    };
+
+    registry.Add(std::move(benchmark));
+}
@@ -0,0 +1,83 @@
+/**
+ * @file      bench_trace_reader.cpp
+ * @brief     TraceReader::GetNextAccess throughput benchmarks.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <benchmark.h>
+
+#include <utils/trace_reader.h>
+
+#include <filesystem>
+#include <memory>
+
+namespace
+{
+    // Register a parse benchmark over a trace whose addresses span the given amount of bits.
+    void RegisterParse(BenchmarkRegistry& registry, BenchmarkSettings const& settings, std::string const& label, unsigned address_bits)
+    {
+        std::size_t const count = settings.Scaled(4000000);
+        std::string const path = (std::filesystem::path(settings.m_scratch_directory) / ("reader_" + label + ".trace")).string();
+        auto file_size = std::make_shared<std::uint64_t>(0);
+
+        Benchmark benchmark;
+        benchmark.m_name = "reader/parse/" + label;
+        benchmark.m_parameters = {{"accesses", std::to_string(count)}, {"address_bits", std::to_string(address_bits)}};
+
+        benchmark.m_setup = [=]()
+        {
+            // Random line addresses, 30% stores.
+            SplitMix64 random(address_bits);
+            address_t const mask = (address_bits >= 64) ? ~address_t(0) : ((address_t(1) << address_bits) - 1);
+
+            std::vector<std::pair<Operation, address_t>> accesses(count);
+            for (auto& [operation, address] : accesses)
+            {
+                operation = (random.Next() % 10 < 3) ? STORE : LOAD;
+                address = (random.Next() & mask) | (address_t(1) << (address_bits - 1));
+            }
+
+            *file_size = WriteTrace(path, accesses);
+        };
+
+        benchmark.m_run = [=]()
+        {
+            TraceReader reader(path);
+
+            Operation operation;
+            address_t address;
+            address_t checksum = 0;
+            std::uint64_t accesses = 0;
+
+            while (reader.GetNextAccess(operation, address))
+            {
+                checksum ^= address + operation;
+                ++accesses;
+            }
+
+            DoNotOptimize(checksum);
+
+            return BenchmarkWork{accesses, *file_size};
+        };
+
+        benchmark.m_teardown = [=]()
+        {
+            std::filesystem::remove(path);
+        };
+
+        registry.Add(std::move(benchmark));
+    }
+}
+
+void RegisterTraceReaderBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings)
+{
+    // Pin-style virtual addresses (as in traces/example_input.trace) and full 48-bit addresses.
+    RegisterParse(registry, settings, "short_addresses", 28);
+    RegisterParse(registry, settings, "wide_addresses", 48);
+}
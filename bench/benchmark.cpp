@@ -0,0 +1,226 @@
+/**
+ * @file      benchmark.cpp
+ * @brief     Microbenchmark harness implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#ifndef TBRIDGE_GIT_REVISION
+    #define TBRIDGE_GIT_REVISION "unknown"
+#endif
+#ifndef TBRIDGE_BUILD_TYPE
+    #define TBRIDGE_BUILD_TYPE "unknown"
+#endif
+
+namespace
+{
+    // Escape a string for JSON output.
+    std::string JsonEscape(std::string const& text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+
+        for (char character : text)
+        {
+            switch (character)
+            {
+                case '"':  escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n";  break;
+                case '\t': escaped += "\\t";  break;
+                default:   escaped += character;
+            }
+        }
+
+        return escaped;
+    }
+
+    // Throughput helper that avoids division by zero.
+    double PerSecond(std::uint64_t amount, double seconds)
+    {
+        return seconds > 0.0 ? static_cast<double>(amount) / seconds : 0.0;
+    }
+}
+
+std::size_t BenchmarkSettings::Scaled(std::size_t count) const
+{
+    return std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(count) * m_scale));
+}
+
+double BenchmarkResult::Min() const
+{
+    return *std::min_element(m_seconds.begin(), m_seconds.end());
+}
+
+double BenchmarkResult::Median() const
+{
+    std::vector<double> sorted(m_seconds);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::size_t const middle = sorted.size() / 2;
+    return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2.0;
+}
+
+double BenchmarkResult::Mean() const
+{
+    return std::accumulate(m_seconds.begin(), m_seconds.end(), 0.0) / static_cast<double>(m_seconds.size());
+}
+
+void BenchmarkRegistry::Add(Benchmark benchmark)
+{
+    m_benchmarks.push_back(std::move(benchmark));
+}
+
+std::vector<BenchmarkResult> BenchmarkRegistry::Run(BenchmarkSettings const& settings) const
+{
+    std::vector<BenchmarkResult> results;
+
+    for (Benchmark const& benchmark : m_benchmarks)
+    {
+        // Skip benchmarks that do not match the filter.
+        if (!settings.m_filter.empty() && benchmark.m_name.find(settings.m_filter) == std::string::npos)
+            continue;
+
+        std::cerr << "Running " << benchmark.m_name << "..." << std::endl;
+
+        if (benchmark.m_setup)
+            benchmark.m_setup();
+
+        BenchmarkResult result{&benchmark, {}, {}};
+
+        // Timed repetitions.
+        for (std::size_t repetition = 0; repetition < settings.m_repetitions; ++repetition)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            result.m_work = benchmark.m_run();
+            auto const end = std::chrono::steady_clock::now();
+
+            result.m_seconds.push_back(std::chrono::duration<double>(end - start).count());
+        }
+
+        if (benchmark.m_teardown)
+            benchmark.m_teardown();
+
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+void BenchmarkRegistry::List(std::ostream& stream) const
+{
+    for (Benchmark const& benchmark : m_benchmarks)
+        stream << benchmark.m_name << std::endl;
+}
+
+void PrintResults(std::ostream& stream, std::vector<BenchmarkResult> const& results)
+{
+    stream << std::setfill(' ') << std::left << std::setw(56) << "Benchmark"
+           << std::right << std::setw(12) << "Median (s)"
+           << std::setw(16) << "Items/s"
+           << std::setw(12) << "MB/s" << std::endl;
+
+    for (BenchmarkResult const& result : results)
+    {
+        double const median = result.Median();
+
+        stream << std::left << std::setw(56) << result.m_benchmark->m_name
+               << std::right << std::fixed << std::setprecision(4) << std::setw(12) << median
+               << std::setprecision(0) << std::setw(16) << PerSecond(result.m_work.m_items, median)
+               << std::setprecision(1) << std::setw(12) << PerSecond(result.m_work.m_bytes, median) / 1e6
+               << std::defaultfloat << std::endl;
+    }
+}
+
+void WriteResultsJson(std::ostream& stream, BenchmarkSettings const& settings, std::vector<BenchmarkResult> const& results)
+{
+    std::time_t const now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    stream << std::setprecision(9);
+    stream << "{" << std::endl;
+    stream << "  \"simulator\": \"" << SIMULATOR_NAME << "\"," << std::endl;
+    stream << "  \"version\": \"" << SIMULATOR_VERSION << "\"," << std::endl;
+    stream << "  \"revision\": \"" << TBRIDGE_GIT_REVISION << "\"," << std::endl;
+    stream << "  \"build_type\": \"" << TBRIDGE_BUILD_TYPE << "\"," << std::endl;
+    stream << "  \"timestamp\": \"" << timestamp << "\"," << std::endl;
+    stream << "  \"repetitions\": " << settings.m_repetitions << "," << std::endl;
+    stream << "  \"scale\": " << settings.m_scale << "," << std::endl;
+    stream << "  \"benchmarks\": [" << std::endl;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        BenchmarkResult const& result = results[i];
+        Benchmark const& benchmark = *result.m_benchmark;
+        double const median = result.Median();
+
+        stream << "    {" << std::endl;
+        stream << "      \"name\": \"" << JsonEscape(benchmark.m_name) << "\"," << std::endl;
+
+        stream << "      \"parameters\": {";
+        for (std::size_t p = 0; p < benchmark.m_parameters.size(); ++p)
+        {
+            stream << (p ? ", " : "") << "\"" << JsonEscape(benchmark.m_parameters[p].first) << "\": \""
+                   << JsonEscape(benchmark.m_parameters[p].second) << "\"";
+        }
+        stream << "}," << std::endl;
+
+        stream << "      \"items\": " << result.m_work.m_items << "," << std::endl;
+        stream << "      \"bytes\": " << result.m_work.m_bytes << "," << std::endl;
+
+        stream << "      \"seconds\": [";
+        for (std::size_t r = 0; r < result.m_seconds.size(); ++r)
+            stream << (r ? ", " : "") << result.m_seconds[r];
+        stream << "]," << std::endl;
+
+        stream << "      \"seconds_min\": " << result.Min() << "," << std::endl;
+        stream << "      \"seconds_median\": " << median << "," << std::endl;
+        stream << "      \"seconds_mean\": " << result.Mean() << "," << std::endl;
+        stream << "      \"items_per_second\": " << PerSecond(result.m_work.m_items, median) << "," << std::endl;
+        stream << "      \"bytes_per_second\": " << PerSecond(result.m_work.m_bytes, median) << std::endl;
+        stream << "    }" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    stream << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+std::uint64_t WriteTrace(std::string const& path, std::vector<std::pair<Operation, address_t>> const& accesses)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open())
+        throw std::runtime_error("Could not write benchmark trace " + path);
+
+    for (auto const& [operation, address] : accesses)
+        file << (operation == STORE ? "ST 0x" : "LD 0x") << std::hex << address << '\n';
+
+    file.close();
+    return std::filesystem::file_size(path);
+}
+
+QuietScope::QuietScope() : m_buffer(std::cout.rdbuf(nullptr))
+{
+}
+
+QuietScope::~QuietScope()
+{
+    std::cout.rdbuf(m_buffer);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file      benchmark.h
+ * @brief     Minimal microbenchmark harness: registration, timing and JSON reporting.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <typedefs.h>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Work performed by a single benchmark iteration. Used to derive throughput.
+struct BenchmarkWork
+{
+    // Items processed (accesses, requests...).
+    std::uint64_t m_items = 0;
+
+    // Bytes processed.
+    std::uint64_t m_bytes = 0;
+};
+
+// Shared settings for every benchmark in a run.
+struct BenchmarkSettings
+{
+    // Timed repetitions per benchmark.
+    std::size_t m_repetitions = 3;
+
+    // Multiplier applied to the default problem sizes.
+    double m_scale = 1.0;
+
+    // Directory used for generated traces.
+    std::string m_scratch_directory;
+
+    // Output file handed to the TraceEngine.
+    std::string m_sink_file = "/dev/null";
+
+    // Only run benchmarks whose name contains this string.
+    std::string m_filter;
+
+    // Scale a default problem size by m_scale.
+    std::size_t Scaled(std::size_t count) const;
+};
+
+// A registered benchmark.
+struct Benchmark
+{
+    // Unique name, used for filtering and comparison across commits.
+    std::string m_name;
+
+    // Parameters describing the configuration (geometry, pattern...).
+    std::vector<std::pair<std::string, std::string>> m_parameters;
+
+    // Prepares the inputs. Runs once, untimed.
+    std::function<void()> m_setup;
+
+    // Timed body. Returns the work performed.
+    std::function<BenchmarkWork()> m_run;
+
+    // Releases the inputs. Runs once, untimed.
+    std::function<void()> m_teardown;
+};
+
+// Measured results for a benchmark.
+struct BenchmarkResult
+{
+    // Benchmark that produced the result.
+    Benchmark const* m_benchmark;
+
+    // Work performed per repetition.
+    BenchmarkWork m_work;
+
+    // Wall time of each repetition, in seconds.
+    std::vector<double> m_seconds;
+
+    // Fastest repetition.
+    double Min() const;
+
+    // Median repetition.
+    double Median() const;
+
+    // Mean of all repetitions.
+    double Mean() const;
+};
+
+class BenchmarkRegistry
+{
+public:
+    // Register a benchmark.
+    void Add(Benchmark benchmark);
+
+    // Run all registered benchmarks matching the filter.
+    std::vector<BenchmarkResult> Run(BenchmarkSettings const& settings) const;
+
+    // Print the names of all registered benchmarks.
+    void List(std::ostream& stream) const;
+private:
+    // Registered benchmarks, in registration order.
+    std::vector<Benchmark> m_benchmarks;
+};
+
+// Print a human readable results table.
+void PrintResults(std::ostream& stream, std::vector<BenchmarkResult> const& results);
+
+// Emit the results as JSON.
+void WriteResultsJson(std::ostream& stream, BenchmarkSettings const& settings, std::vector<BenchmarkResult> const& results);
+
+// Generate a text trace with the given accesses. Returns the file size in bytes.
+std::uint64_t WriteTrace(std::string const& path, std::vector<std::pair<Operation, address_t>> const& accesses);
+
+// Prevents the compiler from discarding a computed value.
+template <typename T>
+inline void DoNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Silences std::cout while in scope. The simulator components report their configuration on construction.
+class QuietScope
+{
+public:
+    QuietScope();
+    ~QuietScope();
+private:
+    // Original stream buffer.
+    std::streambuf* m_buffer;
+};
+
+// Simple deterministic random number generator for reproducible inputs.
+class SplitMix64
+{
+public:
+    explicit SplitMix64(std::uint64_t seed) : m_state(seed) {}
+
+    // Next 64-bit random value.
+    std::uint64_t Next()
+    {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+private:
+    // Generator state.
+    std::uint64_t m_state;
+};
+
+// Benchmark groups.
+void RegisterTraceReaderBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings);
+void RegisterCacheBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings);
+void RegisterTraceEngineBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings);
+void RegisterEndToEndBenchmarks(BenchmarkRegistry& registry, BenchmarkSettings const& settings);
+
+#endif // BENCHMARK_H
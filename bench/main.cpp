@@ -0,0 +1,122 @@
+/**
+ * @file      main.cpp
+ * @brief     Entry point of the microbenchmark suite (tbridge_bench).
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout << SIMULATOR_NAME << " v" << SIMULATOR_VERSION << " microbenchmarks" << std::endl
+                  << "Usage: tbridge_bench [options]" << std::endl
+                  << "Options: " << std::endl
+                  << "  --json <file>         Write the results as JSON ('-' for stdout, table on stderr)" << std::endl
+                  << "  --filter <text>       Only run benchmarks whose name contains <text>" << std::endl
+                  << "  --repetitions <n>     Timed repetitions per benchmark (Default: 3)" << std::endl
+                  << "  --scale <factor>      Multiply the default problem sizes (Default: 1.0)" << std::endl
+                  << "  --scratch <dir>       Directory for generated traces (Default: system temp)" << std::endl
+                  << "  --sink <file>         Output trace written by the TraceEngine (Default: /dev/null)" << std::endl
+                  << "  --list                List the available benchmarks" << std::endl
+                  << "  -h, --help            Show this help message" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSettings settings;
+    settings.m_scratch_directory = (std::filesystem::temp_directory_path() / "tbridge_bench").string();
+
+    std::string json_file;
+    bool list_only = false;
+
+    // Parse command-line arguments.
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const argument = argv[i];
+
+        // Fetch the value of an option that requires one.
+        auto next_value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("The " + argument + " option requires an argument.");
+
+            return argv[++i];
+        };
+
+        if (argument == "-h" || argument == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (argument == "--json")
+            json_file = next_value();
+        else if (argument == "--filter")
+            settings.m_filter = next_value();
+        else if (argument == "--repetitions")
+            settings.m_repetitions = std::stoul(next_value());
+        else if (argument == "--scale")
+            settings.m_scale = std::stod(next_value());
+        else if (argument == "--scratch")
+            settings.m_scratch_directory = next_value();
+        else if (argument == "--sink")
+            settings.m_sink_file = next_value();
+        else if (argument == "--list")
+            list_only = true;
+        else
+        {
+            std::cerr << "Error: Unknown option '" << argument << "'." << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (settings.m_repetitions == 0)
+        throw std::invalid_argument("At least one repetition is required.");
+
+    BenchmarkRegistry registry;
+    RegisterTraceReaderBenchmarks(registry, settings);
+    RegisterCacheBenchmarks(registry, settings);
+    RegisterTraceEngineBenchmarks(registry, settings);
+    RegisterEndToEndBenchmarks(registry, settings);
+
+    if (list_only)
+    {
+        registry.List(std::cout);
+        return 0;
+    }
+
+    std::filesystem::create_directories(settings.m_scratch_directory);
+
+    std::vector<BenchmarkResult> const results = registry.Run(settings);
+
+    // The table goes to stderr when stdout carries the JSON report, so that the report stays parseable.
+    PrintResults(json_file == "-" ? std::cerr : std::cout, results);
+
+    // Emit the JSON report.
+    if (json_file == "-")
+        WriteResultsJson(std::cout, settings, results);
+    else if (!json_file.empty())
+    {
+        std::ofstream json(json_file, std::ios::trunc);
+        if (!json.is_open())
+            throw std::runtime_error("Could not write to output file " + json_file);
+
+        WriteResultsJson(json, settings, results);
+    }
+
+    return 0;
+}
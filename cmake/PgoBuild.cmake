@@ -0,0 +1,162 @@
+# ==============================================================================
+# Project:     TBridge
+# Author:      Victor Jimenez (victor.jimenez@colorado.edu)
+# Institution: Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+# Date:        2026-10-18
+# ==============================================================================
+#
+# Optimized build flow, run by the pgo target (cmake --build <build> --target pgo). Under <build>/pgo:
+#
+#   baseline/    Plain Release build. Generates the training traces and is the reference of the comparison.
+#   train/       Hit-heavy, miss-heavy and store-heavy traces, and their configurations.
+#   optimized/   Instrumented build (TBRIDGE_PGO=GENERATE), run over the training traces, then rebuilt in
+#                place with the profile (TBRIDGE_PGO=USE), link-time optimization and, with TBRIDGE_NATIVE,
+#                -march=native.
+#   profile/     Profile data.
+#
+# The end-to-end benchmarks of both builds are compared at the end. They generate traces of their own, so
+# the comparison is not run on the training traces.
+
+cmake_minimum_required(VERSION 3.19)
+
+foreach(variable TBRIDGE_SOURCE_DIR TBRIDGE_WORK_DIR TBRIDGE_GENERATOR TBRIDGE_CXX_COMPILER)
+    if(NOT ${variable})
+        message(FATAL_ERROR "${variable} is not set; run the pgo target of a configured build instead.")
+    endif()
+endforeach()
+
+set(WORK_DIR ${TBRIDGE_WORK_DIR})
+set(TRAIN_DIR ${WORK_DIR}/train)
+set(PROFILE_DIR ${WORK_DIR}/profile)
+
+# Run a command, stopping the flow if it fails.
+function(tbridge_run step)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO ${step} failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+# Configure a Release build directory with extra cache settings, and build a target.
+function(tbridge_build directory target)
+    tbridge_run("configure" ${CMAKE_COMMAND} -S ${TBRIDGE_SOURCE_DIR} -B ${directory} -G ${TBRIDGE_GENERATOR}
+        -DCMAKE_BUILD_TYPE=Release -DCMAKE_CXX_COMPILER=${TBRIDGE_CXX_COMPILER} "-DCMAKE_CXX_FLAGS=${TBRIDGE_CXX_FLAGS}"
+        -DTBRIDGE_BUILD_BENCHMARKS=ON -DTBRIDGE_BUILD_TOOLS=ON ${ARGN})
+    tbridge_run("build" ${CMAKE_COMMAND} --build ${directory} --target ${target} --parallel)
+endfunction()
+
+# Left-align a value in a column.
+function(tbridge_pad output value width)
+    string(LENGTH "${value}" length)
+    while(length LESS width)
+        string(APPEND value " ")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    set(${output} "${value}" PARENT_SCOPE)
+endfunction()
+
+# Format a ratio of integers with 2 decimals.
+function(tbridge_ratio output numerator denominator)
+    math(EXPR hundredths "(${numerator} * 100 + ${denominator} / 2) / ${denominator}")
+    math(EXPR units "${hundredths} / 100")
+    math(EXPR fraction "${hundredths} % 100")
+    if(fraction LESS 10)
+        set(fraction "0${fraction}")
+    endif()
+    set(${output} "${units}.${fraction}" PARENT_SCOPE)
+endfunction()
+
+# 1. Reference build.
+message(STATUS "PGO: building the baseline...")
+tbridge_build(${WORK_DIR}/baseline all -DTBRIDGE_PGO=OFF -DTBRIDGE_LTO=OFF -DTBRIDGE_NATIVE=OFF)
+
+# 2. Training traces, on a 16 MiB cache: a Zipfian set that fits (hits), uniform accesses over 1 GiB (misses),
+# and store-heavy strided accesses over 4 times the cache (dirty evictions).
+set(hit_heavy_options --pattern zipfian --footprint 8M --write-ratio 0.2)
+set(miss_heavy_options --pattern random --footprint 1G --write-ratio 0.2)
+set(store_heavy_options --pattern strided --stride 64 --footprint 64M --write-ratio 0.9)
+set(workloads hit_heavy miss_heavy store_heavy)
+
+file(MAKE_DIRECTORY ${TRAIN_DIR})
+foreach(workload ${workloads})
+    message(STATUS "PGO: generating the ${workload} training trace...")
+    tbridge_run("trace generation" ${WORK_DIR}/baseline/bin/tbridge_tracegen -o ${TRAIN_DIR}/${workload}.trace
+        --accesses ${TBRIDGE_PGO_ACCESSES} ${${workload}_options})
+
+    file(WRITE ${TRAIN_DIR}/${workload}.conf
+        "[CACHE]\nsets = 32768\nways = 8\nline_size = 64\n\n"
+        "[IO]\ninput_trace_file = \"${TRAIN_DIR}/${workload}.trace\"\noutput_trace_file = \"${TRAIN_DIR}/${workload}.out.trace\"\n")
+endforeach()
+
+# 3. Instrumented build and training runs. Stale profiles would be merged with the new ones.
+file(REMOVE_RECURSE ${PROFILE_DIR})
+message(STATUS "PGO: building the instrumented simulator...")
+tbridge_build(${WORK_DIR}/optimized TBridge -DTBRIDGE_PGO=GENERATE -DTBRIDGE_PGO_DIRECTORY=${PROFILE_DIR}
+    -DTBRIDGE_LTO=OFF -DTBRIDGE_NATIVE=${TBRIDGE_NATIVE})
+
+foreach(workload ${workloads})
+    message(STATUS "PGO: training on ${workload}...")
+    execute_process(COMMAND ${WORK_DIR}/optimized/bin/TBridge -f ${TRAIN_DIR}/${workload}.conf RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO training on ${workload} failed (${result}).")
+    endif()
+endforeach()
+
+# Clang writes raw profiles that must be merged.
+if(TBRIDGE_CXX_COMPILER_ID MATCHES "Clang")
+    string(REGEX MATCH "^[0-9]+" major "${TBRIDGE_CXX_COMPILER_VERSION}")
+    get_filename_component(compiler_dir ${TBRIDGE_CXX_COMPILER} DIRECTORY)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata-${major} llvm-profdata HINTS ${compiler_dir})
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "PGO needs llvm-profdata to merge the Clang profiles.")
+    endif()
+
+    file(GLOB raw_profiles ${PROFILE_DIR}/*.profraw)
+    tbridge_run("profile merge" ${LLVM_PROFDATA} merge -output=${PROFILE_DIR}/tbridge.profdata ${raw_profiles})
+endif()
+
+# 4. Optimized build, in the directory of the instrumented one: GCC finds the profile of each object by its path.
+message(STATUS "PGO: building the optimized simulator...")
+tbridge_build(${WORK_DIR}/optimized all -DTBRIDGE_PGO=USE -DTBRIDGE_PGO_DIRECTORY=${PROFILE_DIR}
+    -DTBRIDGE_LTO=ON -DTBRIDGE_NATIVE=${TBRIDGE_NATIVE})
+
+# 5. Comparison.
+foreach(build baseline optimized)
+    message(STATUS "PGO: benchmarking the ${build} build...")
+    execute_process(COMMAND ${WORK_DIR}/${build}/bin/tbridge_bench --filter end_to_end --scratch ${WORK_DIR}
+        --json ${WORK_DIR}/${build}.json RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO benchmark of the ${build} build failed (${result}).")
+    endif()
+
+    file(READ ${WORK_DIR}/${build}.json ${build}_json)
+endforeach()
+
+string(JSON count LENGTH "${baseline_json}" benchmarks)
+math(EXPR last "${count} - 1")
+
+message("")
+message("Throughput (end-to-end benchmarks, M accesses/s, median of 3):")
+message("    Benchmark               Baseline   Optimized   Speedup")
+
+foreach(i RANGE ${last})
+    string(JSON name GET "${baseline_json}" benchmarks ${i} name)
+    string(JSON baseline_rate GET "${baseline_json}" benchmarks ${i} items_per_second)
+    string(JSON optimized_rate GET "${optimized_json}" benchmarks ${i} items_per_second)
+
+    # Whole accesses per second: CMake only has integer arithmetic.
+    string(REGEX REPLACE "\\..*" "" baseline_rate "${baseline_rate}")
+    string(REGEX REPLACE "\\..*" "" optimized_rate "${optimized_rate}")
+
+    tbridge_ratio(baseline_mrate ${baseline_rate} 1000000)
+    tbridge_ratio(optimized_mrate ${optimized_rate} 1000000)
+    tbridge_ratio(speedup ${optimized_rate} ${baseline_rate})
+
+    tbridge_pad(name_column "${name}" 24)
+    tbridge_pad(baseline_column "${baseline_mrate}" 11)
+    tbridge_pad(optimized_column "${optimized_mrate}" 12)
+    message("    ${name_column}${baseline_column}${optimized_column}${speedup}x")
+endforeach()
+
+message("")
+message("Optimized binaries: ${WORK_DIR}/optimized/bin")
@@ -0,0 +1,230 @@
+/**
+ * @file      address_translator.h
+ * @brief     Address translator class definition. Maps virtual pages to physical frames on first touch.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef ADDRESS_TRANSLATOR_H
+#define ADDRESS_TRANSLATOR_H
+
+#include <typedefs.h>
+#include <utils/config_reader.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Open-addressing map from page numbers to frames with linear probing. Each entry is a single word: the
+// page number plus one in the high bits and the frame in the low frame_bits bits, zero for an empty slot.
+// Pages are never removed. 4 KiB pages cost 8 to 16 bytes of simulator memory per touched page.
+class PageTable
+{
+public:
+    // Constructor. Frames must fit in frame_bits bits.
+    explicit PageTable(unsigned frame_bits);
+
+    // Frame of a page. Pages seen for the first time get the frame returned by allocate(page).
+    template <typename Allocate>
+    std::uint64_t FindOrInsert(std::uint64_t page, Allocate allocate);
+
+    // Prefetch the home slot of a page.
+    void Prefetch(std::uint64_t page) const { __builtin_prefetch(&m_slots[Slot(page)]); }
+
+    // Amount of pages mapped.
+    std::size_t GetSize() const { return m_size; }
+
+    // Bytes used by the table.
+    std::size_t GetMemoryUsage() const { return m_slots.size() * sizeof(std::uint64_t); }
+private:
+    // Bits of an entry that hold the frame.
+    unsigned const c_frame_bits;
+
+    // Largest page number that fits next to the frame.
+    std::uint64_t const c_max_page;
+
+
+    // Slots. The amount is a power of two.
+    std::vector<std::uint64_t> m_slots;
+
+    // Amount of slots minus one.
+    std::size_t m_mask;
+
+    // Amount of pages mapped.
+    std::size_t m_size;
+
+
+    // Home slot of a page.
+    std::size_t Slot(std::uint64_t page) const { return static_cast<std::size_t>((page * 0x9e3779b97f4a7c15ull) >> 32) & m_mask; }
+
+    // Double the amount of slots.
+    void Grow();
+};
+
+// Translation statistics.
+struct TranslationStats
+{
+    // Data accesses translated.
+    std::uint64_t m_accesses = 0;
+
+    // Accesses that missed in the TLB.
+    std::uint64_t m_tlb_misses = 0;
+
+    // Pages touched for the first time.
+    std::uint64_t m_page_faults = 0;
+
+    // Page-table loads sent through the cache.
+    std::uint64_t m_walk_loads = 0;
+};
+
+// Translates the virtual addresses of a trace to physical addresses. Frames are allocated on first touch
+// by the configured policy, out of a physical memory of a configured size. A direct-mapped software TLB
+// serves the common case, and misses look the page up in a PageTable. Optionally, every TLB miss also
+// emits the loads of an x86-64 radix page walk (4 levels for 4 KiB pages, 3 for 2 MiB pages), whose
+// tables get frames of their own on first touch.
+class AddressTranslator
+{
+public:
+    // Constructor from a configuration.
+    explicit AddressTranslator(Config const& config);
+
+    // Translate an access and append it to the output, after the loads of its page walk on a TLB miss.
+    // FLUSH passes through unchanged. The access keeps its timestamp; the walk loads have none.
+    void Translate(MemoryAccess const& access, std::vector<MemoryAccess>& output)
+    {
+        std::uint64_t const page = access.m_address >> c_page_shift;
+        std::size_t const entry = static_cast<std::size_t>(page) & c_tlb_mask;
+
+        if (access.m_operation == FLUSH || m_tlb_pages[entry] != page)
+        {
+            TranslateSlow(access, output);
+            return;
+        }
+
+        ++m_stats.m_accesses;
+        output.push_back({access.m_operation, (m_tlb_frames[entry] << c_page_shift) | (access.m_address & c_page_mask), access.m_timestamp});
+    }
+
+    // Prefetch the page-table slot of an access that will miss in the TLB as it stands.
+    void Prefetch(address_t const address) const
+    {
+        std::uint64_t const page = address >> c_page_shift;
+
+        if (m_tlb_pages[static_cast<std::size_t>(page) & c_tlb_mask] != page)
+            m_pages.Prefetch(page);
+    }
+
+    // Print the translation settings.
+    void PrintConfiguration(std::ostream& stream) const;
+
+    // Print the translation statistics.
+    void PrintStatistics(std::ostream& stream) const;
+
+    // Translation statistics.
+    TranslationStats const& GetStats() const { return m_stats; }
+private:
+    // Page size.
+    std::size_t const c_page_size;
+
+    // Shift from an address to its page number.
+    unsigned const c_page_shift;
+
+    // Byte within page mask.
+    address_t const c_page_mask;
+
+    // Frame allocation policy.
+    PageAllocation const c_allocation;
+
+    // Amount of frames.
+    std::uint64_t const c_frame_count;
+
+    // NUMA nodes, and frames per node.
+    std::uint64_t const c_node_count;
+    std::uint64_t const c_node_frames;
+
+    // Bits of the random permutation domain, the smallest power of two that holds all frames.
+    unsigned const c_permutation_bits;
+
+    // Keys of the random permutation.
+    std::uint64_t const c_permutation_keys[2];
+
+    // TLB entries minus one.
+    std::size_t const c_tlb_mask;
+
+    // Emit page-walk loads.
+    bool const c_page_walks;
+
+    // Page-table levels walked: 4 for 4 KiB pages, 3 for 2 MiB pages.
+    unsigned const c_walk_levels;
+
+
+    // Frames of the data pages.
+    PageTable m_pages;
+
+    // Frames of the page-table pages below the root, keyed by level and the address bits above it.
+    PageTable m_tables;
+
+    // Frame of the root table.
+    std::uint64_t m_root_frame;
+
+    // Frames handed out so far, overall and per NUMA node.
+    std::uint64_t m_allocated;
+    std::vector<std::uint64_t> m_node_allocated;
+
+    // TLB: page and frame of each entry. Pages start as an impossible page number.
+    std::vector<std::uint64_t> m_tlb_pages;
+    std::vector<std::uint64_t> m_tlb_frames;
+
+    // Translation statistics.
+    TranslationStats m_stats;
+
+
+    // Translate a FLUSH or a TLB miss.
+    void TranslateSlow(MemoryAccess const& access, std::vector<MemoryAccess>& output);
+
+    // Hand out a frame for a page.
+    std::uint64_t AllocateFrame(std::uint64_t page);
+
+    // Bijection of [0, frames) used by the random policy.
+    std::uint64_t Permute(std::uint64_t index) const;
+};
+
+template <typename Allocate>
+std::uint64_t PageTable::FindOrInsert(std::uint64_t page, Allocate allocate)
+{
+    if (page >= c_max_page)
+        throw std::runtime_error("Address translation: page number " + std::to_string(page) + " does not fit next to the frame numbers.");
+
+    std::uint64_t const frame_mask = (std::uint64_t(1) << c_frame_bits) - 1;
+    std::uint64_t const tag = (page + 1) << c_frame_bits;
+
+    for (std::size_t slot = Slot(page);; slot = (slot + 1) & m_mask)
+    {
+        std::uint64_t const entry = m_slots[slot];
+
+        if ((entry & ~frame_mask) == tag)
+            return entry & frame_mask;
+
+        if (entry != 0)
+            continue;
+
+        // First touch.
+        std::uint64_t const frame = allocate(page);
+        m_slots[slot] = tag | frame;
+
+        // Keep the load factor at most 3/4.
+        if (++m_size * 4 > m_slots.size() * 3)
+            Grow();
+
+        return frame;
+    }
+}
+
+#endif // ADDRESS_TRANSLATOR_H
@@ -14,25 +14,57 @@
 #define CACHE_H
 
 #include <core/cache_components.h>
-
+#include <core/cache_model.h>
+#include <utils/clock.h>
+#include <utils/config_reader.h>
+#include <utils/mapped_arena.h>
+#include <utils/memory_sink.h>
+
+#include <array>
+#include <iosfwd>
+#include <memory>
 #include <tuple>
 #include <vector>
 
-class Cache
+class Cache final : public CacheModel
 {
 public:
-    // Constructor. Initializes all the members.
-    Cache(std::size_t sets, std::size_t ways, std::size_t line_size);
+    // Constructor. Initializes all the members. Memory requests are sent to the sink, which must outlive the cache.
+    // A flush point in the given mode follows every flush_interval accesses (0 for none). Store misses fill the line
+    // unless write_allocate is false; streaming stores bypass the cache and invalidate the line. The sets are
+    // backed by transparent huge pages unless huge_pages is false.
+    Cache(std::size_t sets, std::size_t ways, std::size_t line_size, MemorySink& sink, std::size_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE,
+          std::uint64_t flush_interval = 0, FlushMode flush_mode = FlushMode::INVALIDATE, WritePolicy write_policy = WritePolicy::WRITE_BACK,
+          bool write_allocate = true, bool streaming_stores = false, bool huge_pages = true);
+
+    // Constructor from a configuration.
+    Cache(Config const& config, MemorySink& sink);
+
+    // Destructor. Flushes the cache and unmaps the sets.
+    ~Cache() override;
 
-    // Destructor. Deallocates all the members.
-    ~Cache();
+    // The cache owns its sets.
+    Cache(Cache const&) = delete;
+    Cache& operator=(Cache const&) = delete;
 
     
-    // Perform an operation on the cache.
-    void PerformOperation(Operation const operation, address_t const address);
+    // Perform an operation on the cache. FLUSH performs a flush point.
+    void PerformOperation(Operation const operation, address_t const address) override;
+
+    // Perform a batch of operations, in order. Set metadata is prefetched prefetch_distance accesses ahead.
+    void PerformOperations(MemoryAccess const* accesses, std::size_t const count) override;
+
+    // Flush the sets that hold lines.
+    void Flush() override;
 
-    // Flush all cache sets.
-    void Flush();
+    // Write back the dirty lines of the sets that hold any.
+    void Writeback() override;
+
+    // Print the cache geometry.
+    void PrintConfiguration(std::ostream& stream) const override;
+
+    // Current cycle of the cache clock.
+    timestamp_t GetCycle() const override { return m_clock.GetCycle(); }
 private:
     // Amount of sets.
     std::size_t const c_set_count;
@@ -55,13 +87,110 @@ private:
     // Set mask.
     address_t const c_set_mask;
 
+    // Accesses between the prefetch of the set lines and the access itself. Zero disables the pipeline.
+    std::size_t const c_prefetch_distance;
+
+    // Accesses per epoch. Zero disables the epochs.
+    std::uint64_t const c_flush_interval;
+
+    // What a flush point does.
+    FlushMode const c_flush_mode;
+
+    // Send every store to memory, keeping the lines clean.
+    bool const c_write_through;
+
+    // Fill the line on a store miss.
+    bool const c_write_allocate;
+
+    // Send every store straight to memory, invalidating the cached line.
+    bool const c_streaming_stores;
+
+
+    // Bytes of arena per set: the CacheSet followed by its storage, rounded up to a host cache line.
+    std::size_t const c_set_stride;
+
+    // Cache Sets, c_set_stride bytes apart. A set is only constructed the first time it is accessed, so
+    // creating the cache is O(1) and only the pages of the touched sets become resident.
+    std::unique_ptr<MappedArena> m_arena;
+    char* m_set_base;
+
+    // Sets constructed so far, one bit per set.
+    std::vector<std::uint64_t> m_initialized_sets;
+
+    // Destination of the memory requests.
+    MemorySink& m_sink;
+
+    // Clock of this cache instance.
+    Clock m_clock;
 
-    // Cache Sets.
-    std::vector<CacheSet*> m_sets;
+    // Accesses left in the current epoch.
+    std::uint64_t m_epoch_remaining;
 
+    // Summary bitmaps, one bit per set: sets that may hold valid lines, and sets that may hold dirty lines.
+    // Bits are set on access and cleared by flushes, so flushes only visit the sets that need it.
+    std::vector<std::uint64_t> m_occupied_sets;
+    std::vector<std::uint64_t> m_dirty_sets;
+
+
+    // Location of a recently accessed line.
+    struct L0Entry
+    {
+        // Line address.
+        address_t m_address;
+
+        // Set holding the line.
+        CacheSet* m_set;
+
+        // Way holding the line.
+        way_t m_way;
+
+        // The entry holds a line. Any address, all-ones included, is a line address when lines are 1 byte.
+        bool m_valid;
+    };
+
+    // Amount of recently accessed lines remembered by the L0.
+    static constexpr std::size_t c_l0_size = 4;
+
+    // Recently accessed lines. Checked before the set lookup; entries are hints validated against the set.
+    std::array<L0Entry, c_l0_size> m_l0;
+
+    // Next L0 entry to replace.
+    std::size_t m_l0_next;
+
+
+    // Location of a set in the arena. The set may not be constructed yet.
+    CacheSet* SetAt(set_t const set) const { return reinterpret_cast<CacheSet*>(m_set_base + set * c_set_stride); }
+
+    // A set, constructed on its first access.
+    CacheSet* GetSet(set_t const set)
+    {
+        if (!(m_initialized_sets[set >> 6] >> (set & 63) & 1))
+            InitializeSet(set);
+
+        return SetAt(set);
+    }
+
+    // Construct a set in its arena slot.
+    void InitializeSet(set_t const set);
 
     // Parses the tag and set from an address.
     std::tuple<address_t, tag_t, set_t> ParseAddress(address_t address) const;
+
+    // Remember the location of an accessed line in the L0.
+    void RecordL0(address_t const address, CacheSet* set, way_t const way);
+
+    // Perform a store under a write-through, write-no-allocate or streaming policy.
+    void PerformStore(address_t const address);
+
+    // Advance the clock after an access, and end the epoch when it is over.
+    void Retire();
+
+    // Flush or write back the cache, following the flush mode.
+    void FlushPoint();
+
+    // Call a function with the index of every set marked in a summary bitmap, in set order.
+    template <typename Function>
+    static void ForEachMarkedSet(std::vector<std::uint64_t> const& summary, Function function);
 };
 
 #endif // CACHE_H
\ No newline at end of file
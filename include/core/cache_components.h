@@ -15,6 +15,7 @@
 #define CACHE_COMPONENTS_H
 
 #include <typedefs.h>
+#include <utils/memory_sink.h>
 
 struct CacheLine
 {
@@ -35,26 +36,51 @@ struct CacheLine
 
     // Last Access Timestamp.
     timestamp_t m_last_access;
+
+    // Neighbours in the LRU list of hashed sets (towards the MRU and LRU ends).
+    way_t m_lru_prev;
+    way_t m_lru_next;
 };
 
 class CacheSet
 {
 public:
-    // Initialize the cache set.
-    CacheSet(way_t ways, set_t set);
+    // Initialize the cache set. The lines, the dirty mask of large sets and the hash table live in the given
+    // storage, GetStorageSize(ways) bytes aligned to 8, which belongs to the owner. The owner is responsible for
+    // flushing the set before releasing it.
+    CacheSet(way_t ways, set_t set, void* storage);
 
-    // Class Destructor.
-    ~CacheSet();
+    // Bytes of storage a set of the given ways needs.
+    static std::size_t GetStorageSize(way_t ways);
     
     
-    // Perform a Load.
-    void Load(address_t const address, tag_t const tag);
+    // Perform a Load at the given cycle. Misses and evictions are sent to the sink. Returns the way holding the line.
+    way_t Load(address_t const address, tag_t const tag, timestamp_t const cycle, MemorySink& sink);
+
+    // Perform a Store at the given cycle. Misses and evictions are sent to the sink. Returns the way holding the line.
+    way_t Store(address_t const address, tag_t const tag, timestamp_t const cycle, MemorySink& sink);
+
+    // Fast path for a hit on a known way: only updates the replacement and dirty state.
+    // Returns false if the way no longer holds the address.
+    bool Touch(way_t const way, address_t const address, Operation const operation, timestamp_t const cycle);
+
+    // Way holding an address, NO_WAY if it is not in the set. Does not change any state.
+    way_t Find(address_t const address) const { return IsPresent(address); }
 
-    // Perform a Store.
-    void Store(address_t const address, tag_t const tag);
+    // Invalidate the line of an address, if present, writing it back first if dirty. Returns true if it was present.
+    bool Invalidate(address_t const address, timestamp_t const cycle, MemorySink& sink);
 
-    // Flush existing lines to memory.
-    void Flush();
+    // Write back the dirty lines, in way order, and invalidate the set.
+    void Flush(timestamp_t const cycle, MemorySink& sink);
+
+    // Write back the dirty lines, in way order. The lines stay valid and become clean.
+    void Writeback(timestamp_t const cycle, MemorySink& sink);
+
+    // Index of the set in the cache.
+    set_t GetIndex() const { return c_set_index; }
+
+    // Prefetch the metadata that a lookup of the address will read. Does not change any state.
+    void Prefetch(address_t const address) const;
 
 private:
     // Amount of ways.
@@ -66,16 +92,107 @@ private:
     // All the ways in the set.
     CacheLine* m_ways;
 
+    // Most recently used way. Checked first on lookups.
+    way_t m_mru_way;
+
+    // Dirty ways, one bit per way. Points to m_dirty_word for sets of up to 64 ways, so that the common
+    // case lives next to the rest of the set metadata, and into the storage otherwise.
+    std::uint64_t* m_dirty_mask;
+
+    // Storage of the dirty mask of small sets.
+    std::uint64_t m_dirty_word;
+
+
+    // Hashed organization, used for sets with at least HASHED_SET_MIN_WAYS ways.
+    // Lookup, hit update and victim selection are O(1) instead of O(ways).
+    bool const c_hashed;
+
+    // Open-addressing (linear probing) table from line address to way + 1. Zero marks an empty slot.
+    way_t* m_table;
+
+    // Table slots minus one. The table size is a power of 2.
+    std::size_t m_table_mask;
+
+    // Shift that maps a 64-bit hash to a table slot.
+    unsigned m_table_shift;
+
+    // Most and least recently used ways of the intrusive LRU list.
+    way_t m_lru_head;
+    way_t m_lru_tail;
+
+    // Valid ways. Invalid ways always form the suffix [m_valid_count, ways).
+    way_t m_valid_count;
+
 
     // Locate a line for a given address. If not present, allocate a line for the given address.
-    CacheLine& LocateAndAllocate(address_t const address, tag_t const tag);
+    CacheLine& LocateAndAllocate(address_t const address, tag_t const tag, timestamp_t const cycle, MemorySink& sink);
 
     // Evict a line using LRU policy. Returns the way evicted.
-    way_t EvictLRU();
+    way_t EvictLRU(timestamp_t const cycle, MemorySink& sink);
 
     // Is the address in the set?
     // Returns the way if found, NO_WAY otherwise.
     way_t IsPresent(address_t const address) const;
+
+    // Update the replacement state after an access to a way.
+    void Promote(way_t const way, timestamp_t const cycle);
+
+    // Mark a way dirty or clean, in the line and in the dirty mask.
+    void MarkDirty(way_t const way);
+    void MarkClean(way_t const way);
+
+    // Call a function with every dirty way, in way order.
+    template <typename Function>
+    void ForEachDirty(Function function) const;
+
+
+    // Home slot of an address in the hash table.
+    std::size_t HashSlot(address_t const address) const;
+
+    // Find the way holding an address using the hash table. Returns NO_WAY if not found.
+    way_t HashFind(address_t const address) const;
+
+    // Add a valid way to the hash table.
+    void HashInsert(way_t const way);
+
+    // Remove a valid way from the hash table (backward-shift deletion, no tombstones).
+    void HashErase(way_t const way);
+
+    // Point the table slot of a valid way to another way.
+    void HashReplace(way_t const way, way_t const new_way);
+
+    // Unlink a way from the LRU list.
+    void ListUnlink(way_t const way);
+
+    // Link a way at the MRU end of the LRU list.
+    void ListPushFront(way_t const way);
 };
 
+inline void CacheSet::Prefetch(address_t const address) const
+{
+    // Hashed sets: the home slot of the address. The way it points to is unknown until the slot is read.
+    if (c_hashed)
+    {
+        __builtin_prefetch(&m_table[HashSlot(address)]);
+        return;
+    }
+
+    // Every cache line of host memory spanned by the ways.
+    char const* const begin = reinterpret_cast<char const*>(m_ways);
+    char const* const end = reinterpret_cast<char const*>(m_ways + c_ways_count);
+
+    for (char const* line = begin; line < end; line += 64)
+        __builtin_prefetch(line);
+}
+
+template <typename Function>
+void CacheSet::ForEachDirty(Function function) const
+{
+    std::size_t const words = (c_ways_count + 63) / 64;
+
+    for (std::size_t word = 0; word < words; ++word)
+        for (std::uint64_t bits = m_dirty_mask[word]; bits != 0; bits &= bits - 1)
+            function(static_cast<way_t>(word * 64 + __builtin_ctzll(bits)));
+}
+
 #endif // CACHE_COMPONENTS_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file      cache_model.h
+ * @brief     Interface shared by the cache organizations, and the factory that builds them from a configuration.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef CACHE_MODEL_H
+#define CACHE_MODEL_H
+
+#include <typedefs.h>
+#include <utils/config_reader.h>
+#include <utils/memory_sink.h>
+
+#include <iosfwd>
+#include <memory>
+
+class CacheModel
+{
+public:
+    // Virtual destructor for the organizations.
+    virtual ~CacheModel() = default;
+
+    // Perform an operation on the cache.
+    virtual void PerformOperation(Operation const operation, address_t const address) = 0;
+
+    // Perform a batch of operations, in order.
+    virtual void PerformOperations(MemoryAccess const* accesses, std::size_t const count) = 0;
+
+    // Write back every dirty line and invalidate the cache.
+    virtual void Flush() = 0;
+
+    // Write back every dirty line. The lines stay in the cache, clean.
+    virtual void Writeback() = 0;
+
+    // Print the cache geometry.
+    virtual void PrintConfiguration(std::ostream& stream) const = 0;
+
+    // Print the statistics of the stages in front of the cache, if any.
+    virtual void PrintStatistics(std::ostream& stream) const { (void)stream; }
+
+    // Current cycle of the cache clock.
+    virtual timestamp_t GetCycle() const = 0;
+};
+
+// Build the cache organization selected by the configuration, behind an issue-timing and a translation stage
+// when enabled. Requests are sent to the sink, which must outlive the cache.
+std::unique_ptr<CacheModel> CreateCacheModel(Config const& config, MemorySink& sink);
+
+// Build the cache organization alone, without the stages in front of it.
+std::unique_ptr<CacheModel> CreateCacheOrganization(Config const& config, MemorySink& sink);
+
+#endif // CACHE_MODEL_H
@@ -0,0 +1,166 @@
+/**
+ * @file      sectored_cache.h
+ * @brief     Sectored (sub-blocked) cache class definition. Models multi-GB DRAM caches with compact metadata.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SECTORED_CACHE_H
+#define SECTORED_CACHE_H
+
+#include <core/cache_model.h>
+#include <utils/bit_packed_array.h>
+#include <utils/clock.h>
+
+#include <vector>
+
+// Blocks are allocated as a whole but filled and written back one sector at a time, so every request
+// sent to the sink is sector sized. The metadata is stored in flat bit-packed arrays indexed by
+// set * ways + way: the tag (sized from the address width), a valid and a dirty bit per sector, and a
+// per-set LRU stack of 4-bit way indices. There is no per-line object and no per-set allocation.
+class SectoredCache final : public CacheModel
+{
+public:
+    // Maximum associativity, bounded by the packed LRU stacks.
+    static constexpr std::size_t c_max_ways = 16;
+
+    // Maximum sectors per block, bounded by the 64-bit sector masks.
+    static constexpr std::size_t c_max_sectors = 64;
+
+    // Constructor. Addresses must fit in address_bits.
+    // A flush point in the given mode follows every flush_interval accesses (0 for none).
+    SectoredCache(std::size_t sets, std::size_t ways, std::size_t block_size, std::size_t sector_size, unsigned address_bits, MemorySink& sink,
+                  std::size_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE, std::uint64_t flush_interval = 0, FlushMode flush_mode = FlushMode::INVALIDATE);
+
+    // Constructor from a configuration.
+    SectoredCache(Config const& config, MemorySink& sink);
+
+    // Destructor. Flushes the cache.
+    ~SectoredCache() override;
+
+    // The cache owns its metadata.
+    SectoredCache(SectoredCache const&) = delete;
+    SectoredCache& operator=(SectoredCache const&) = delete;
+
+
+    // Perform an operation on the cache. FLUSH performs a flush point.
+    void PerformOperation(Operation const operation, address_t const address) override;
+
+    // Perform a batch of operations, in order. Set metadata is prefetched prefetch_distance accesses ahead.
+    void PerformOperations(MemoryAccess const* accesses, std::size_t const count) override;
+
+    // Write back every dirty sector and invalidate the cache.
+    void Flush() override;
+
+    // Write back every dirty sector. The blocks stay in the cache, clean.
+    void Writeback() override;
+
+    // Print the cache geometry.
+    void PrintConfiguration(std::ostream& stream) const override;
+
+    // Current cycle of the cache clock.
+    timestamp_t GetCycle() const override { return m_clock.GetCycle(); }
+
+    // Bytes of simulator memory taken by the metadata.
+    std::size_t GetMetadataBytes() const;
+private:
+    // Amount of sets.
+    std::size_t const c_set_count;
+
+    // Amount of ways.
+    std::size_t const c_way_count;
+
+    // Block (allocation unit) size.
+    std::size_t const c_block_size;
+
+    // Sector (transfer unit) size.
+    std::size_t const c_sector_size;
+
+    // Sectors per block.
+    std::size_t const c_sectors_per_block;
+
+    // Width of the addresses.
+    unsigned const c_address_bits;
+
+    // Shift needed from address to get the sector index.
+    address_t const c_sector_shift;
+
+    // Shift needed from address to get set.
+    address_t const c_set_shift;
+
+    // Shift needed from address to get tag.
+    address_t const c_tag_shift;
+
+    // Set mask.
+    address_t const c_set_mask;
+
+    // Addresses with any of these bits set do not fit in the address width.
+    address_t const c_address_overflow_mask;
+
+    // Accesses between the prefetch of the set metadata and the access itself. Zero disables the pipeline.
+    std::size_t const c_prefetch_distance;
+
+    // Accesses per epoch. Zero disables the epochs.
+    std::uint64_t const c_flush_interval;
+
+    // What a flush point does.
+    FlushMode const c_flush_mode;
+
+
+    // Tag plus one of every way. Zero marks an invalid block.
+    BitPackedArray m_tags;
+
+    // Valid sectors of every way.
+    BitPackedArray m_valid_sectors;
+
+    // Dirty sectors of every way.
+    BitPackedArray m_dirty_sectors;
+
+    // Per-set LRU stacks: 4-bit way indices, most recently used in the lowest nibble. Empty for direct-mapped caches.
+    std::vector<std::uint64_t> m_lru_stacks;
+
+    // Destination of the memory requests.
+    MemorySink& m_sink;
+
+    // Clock of this cache instance.
+    Clock m_clock;
+
+    // Accesses left in the current epoch.
+    std::uint64_t m_epoch_remaining;
+
+    // Summary bitmaps, one bit per set: sets that may hold blocks, and sets that may hold dirty sectors.
+    std::vector<std::uint64_t> m_occupied_sets;
+    std::vector<std::uint64_t> m_dirty_sets;
+
+
+    // Flush or write back the cache, following the flush mode.
+    void FlushPoint();
+
+    // Write back the dirty sectors of a way. The way stays valid.
+    void WritebackWay(std::size_t const set, way_t const way, timestamp_t const cycle);
+
+    // Prefetch the metadata of the set of an address.
+    void PrefetchSet(address_t const address) const;
+
+    // Move a way to the top of the LRU stack of its set.
+    void Promote(std::size_t const set, way_t const way);
+
+    // Least recently used way of a full set.
+    way_t GetLRUWay(std::size_t const set) const;
+
+    // Write back the dirty sectors of a way and invalidate it.
+    void Evict(std::size_t const set, way_t const way, timestamp_t const cycle);
+
+    // Address of a sector.
+    address_t SectorAddress(std::uint64_t const tag_field, std::size_t const set, std::size_t const sector) const;
+
+    // LRU stack with the ways in index order.
+    std::uint64_t InitialLRUStack() const;
+};
+
+#endif // SECTORED_CACHE_H
@@ -0,0 +1,120 @@
+/**
+ * @file      timed_cache.h
+ * @brief     Timed cache class definition. Stamps the requests of a cache with the issue cycle of their access.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef TIMED_CACHE_H
+#define TIMED_CACHE_H
+
+#include <core/cache_model.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Issue-timing stage around a cache organization. Every access gets an issue cycle from the timing of the
+// configuration, and the requests it causes leave hit_latency cycles later. The cache keeps its own clock for
+// replacement: its requests carry the position of their access, which the stage maps to the issue cycle of that
+// access before they reach the sink. The writebacks of a flush point go with the next access slot: with a
+// core issuing one access per cycle and no latency, the cycles are the positions of the access timing.
+class TimedCache final : public CacheModel
+{
+public:
+    // Constructor. Builds the cache organization of the configuration, in front of the sink.
+    TimedCache(Config const& config, MemorySink& sink);
+
+    // Time and perform an operation.
+    void PerformOperation(Operation const operation, address_t const address) override;
+
+    // Time and perform a batch of operations, in order.
+    void PerformOperations(MemoryAccess const* accesses, std::size_t const count) override;
+
+    // Flush the cache. The writebacks go with the next access slot.
+    void Flush() override;
+
+    // Write back the dirty lines of the cache. The writebacks go with the next access slot.
+    void Writeback() override;
+
+    // Print the cache geometry and the timing settings.
+    void PrintConfiguration(std::ostream& stream) const override;
+
+    // Print the statistics of the cache.
+    void PrintStatistics(std::ostream& stream) const override { m_cache->PrintStatistics(stream); }
+
+    // Current cycle of the cache clock.
+    timestamp_t GetCycle() const override { return m_cache->GetCycle(); }
+private:
+    // Rewrites the cycle of the requests of the cache, from the position of their access to its issue cycle.
+    class IssueStage final : public MemorySink
+    {
+    public:
+        // Constructor.
+        IssueStage(TimedCache const& owner, MemorySink& target) : m_owner(owner), m_target(target) {}
+
+        // Stamp a request and forward it.
+        void Send(MemoryRequest const& request) override
+        {
+            std::vector<timestamp_t> const& cycles = m_owner.m_request_cycles;
+            timestamp_t const index = std::min<timestamp_t>(request.m_cycle - m_owner.m_first_position, cycles.size() - 1);
+
+            m_target.Send({request.m_operation, request.m_address, cycles[index]});
+        }
+    private:
+        // Timing state.
+        TimedCache const& m_owner;
+
+        // Destination of the requests.
+        MemorySink& m_target;
+    };
+
+    // Fractional bits of the model time.
+    static constexpr unsigned c_fraction_bits = 16;
+
+    // Source of the issue cycles.
+    IssueTiming const c_timing;
+
+    // Model time per access and per instruction, in 1/65536 cycles.
+    std::uint64_t const c_access_period;
+    std::uint64_t const c_instruction_period;
+
+    // Cycles from the issue of an access to its requests.
+    timestamp_t const c_hit_latency;
+
+
+    // Stage between the cache and the sink.
+    IssueStage m_stage;
+
+    // Model time of the last access, in 1/65536 cycles (RATE and INSTRUCTION_GAPS).
+    std::uint64_t m_time;
+
+    // Issue cycle of the last access (TRACE).
+    timestamp_t m_trace_cycle;
+
+    // Cache clock of the first access of the current batch.
+    timestamp_t m_first_position;
+
+    // Request cycle of every access of the current batch, flush points excluded, then of the next access slot.
+    std::vector<timestamp_t> m_request_cycles;
+
+    // Cache fed with the accesses. Declared last: its destructor flushes through the stage, which reads the timing state.
+    std::unique_ptr<CacheModel> m_cache;
+
+
+    // Advance the timing to the next access and return its issue cycle.
+    timestamp_t Issue(timestamp_t timestamp);
+
+    // Request cycle of the next access slot, for the flush points.
+    timestamp_t GetNextCycle() const;
+
+    // Restart the request cycles at the current cache clock, with the next access slot only.
+    void ResetRequestCycles();
+};
+
+#endif // TIMED_CACHE_H
@@ -0,0 +1,65 @@
+/**
+ * @file      translated_cache.h
+ * @brief     Translated cache class definition. Runs a cache on the physical addresses of a virtual trace.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef TRANSLATED_CACHE_H
+#define TRANSLATED_CACHE_H
+
+#include <core/address_translator.h>
+#include <core/cache_model.h>
+
+#include <memory>
+#include <vector>
+
+// Translation stage in front of a cache organization. Every batch is translated into physical addresses,
+// page-walk loads included, and handed to the cache as one batch, so the cache keeps its prefetch pipeline.
+class TranslatedCache final : public CacheModel
+{
+public:
+    // Constructor. Takes ownership of the cache.
+    TranslatedCache(Config const& config, std::unique_ptr<CacheModel> cache);
+
+    // Translate and perform an operation.
+    void PerformOperation(Operation const operation, address_t const address) override;
+
+    // Translate and perform a batch of operations, in order.
+    void PerformOperations(MemoryAccess const* accesses, std::size_t const count) override;
+
+    // Flush the cache.
+    void Flush() override { m_cache->Flush(); }
+
+    // Write back the dirty lines of the cache.
+    void Writeback() override { m_cache->Writeback(); }
+
+    // Print the cache geometry and the translation settings.
+    void PrintConfiguration(std::ostream& stream) const override;
+
+    // Print the translation statistics.
+    void PrintStatistics(std::ostream& stream) const override { m_translator.PrintStatistics(stream); }
+
+    // Current cycle of the cache clock.
+    timestamp_t GetCycle() const override { return m_cache->GetCycle(); }
+private:
+    // Accesses between the prefetch of a page-table slot and the translation. Zero disables the prefetches.
+    std::size_t const c_prefetch_distance;
+
+
+    // Cache fed with the physical addresses.
+    std::unique_ptr<CacheModel> m_cache;
+
+    // Translation state.
+    AddressTranslator m_translator;
+
+    // Translated accesses of the current batch.
+    std::vector<MemoryAccess> m_translated;
+};
+
+#endif // TRANSLATED_CACHE_H
@@ -0,0 +1,43 @@
+/**
+ * @file      tbridge.h
+ * @brief     Public API of libtbridge, for embedding the simulator in instrumentation tools.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ * 
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ * 
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef TBRIDGE_H
+#define TBRIDGE_H
+
+// Usage:
+//
+//     Config config{};
+//     config.m_sets = 32768; config.m_ways = 8; config.m_line_size = 64;
+//
+//     CallbackSink sink([](MemoryRequest const& request) { /* Forward to the DRAM model. */ });
+//     Cache cache(config, sink);                    // Or CreateCacheModel(config, sink) for any organization.
+//
+//     cache.PerformOperation(LOAD, address);        // One access at a time...
+//     cache.PerformOperations(accesses, count);     // ...or in batches.
+//     cache.Flush();                                // Write back the dirty lines.
+//
+// Instances share no state: each cache owns its clock and sends its requests to its own sink.
+
+#include <typedefs.h>
+#include <core/cache.h>
+#include <core/cache_model.h>
+#include <core/sectored_cache.h>
+#include <core/timed_cache.h>
+#include <core/translated_cache.h>
+#include <utils/config_reader.h>
+#include <utils/dram_analyzer.h>
+#include <utils/memory_sink.h>
+#include <utils/trace_engine.h>
+#include <utils/trace_reader.h>
+#include <utils/write_combining_buffer.h>
+
+#endif // TBRIDGE_H
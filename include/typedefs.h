@@ -34,14 +34,93 @@ using timestamp_t = uint64_t;
 
 // Constants.
 #define DEFAULT_CONFIG_FILE "sim.conf"
+#define DEFAULT_BATCH_OUTPUT_DIRECTORY "batch_output"
+#define DEFAULT_SLICE_WARMUP 1000000
 #define TIMESTAMP_MAX UINT64_MAX
 #define NO_WAY static_cast<way_t>(-1)
 
+// Accesses handed to the cache per batch.
+#define ACCESS_BATCH_SIZE 4096
+
+// Batches each queue of the pipelined mode holds. A full queue stalls the stage that feeds it.
+#define PIPELINE_QUEUE_BATCHES 16
+
+// Accesses decoded ahead of the one being performed, so that their set metadata can be prefetched. Zero disables the pipeline.
+#define DEFAULT_PREFETCH_DISTANCE 8
+
+// Largest prefetch distance. The decoded window holds twice as many accesses.
+#define MAX_PREFETCH_DISTANCE 64
+
+// Largest write-combining buffer. Entries are searched linearly.
+#define MAX_WRITE_COMBINING_ENTRIES 256
+
+// Sets with at least this many ways use the hashed organization (O(1) lookup and LRU).
+#define HASHED_SET_MIN_WAYS 64
+
 // Operation types for cache access.
 enum Operation
 {
     LOAD,
-    STORE
+    STORE,
+
+    // Flush point (FLUSH marker in the trace). Carries no address and is never sent to memory.
+    FLUSH
+};
+
+// What a flush point does to the cache.
+enum class FlushMode
+{
+    // Write back the dirty lines and invalidate the whole cache.
+    INVALIDATE,
+
+    // Write back the dirty lines and keep them, clean, in the cache.
+    WRITEBACK
+};
+
+// When stores reach memory.
+enum class WritePolicy
+{
+    // Stores dirty the line. Dirty lines are written back on eviction and at flush points.
+    WRITE_BACK,
+
+    // Every store is also sent to memory. Lines are never dirty.
+    WRITE_THROUGH
+};
+
+// How a consumer waits for data from a producer.
+enum class WaitPolicy
+{
+    // Busy-wait. Lowest latency, but burns a core.
+    SPIN,
+
+    // Spin briefly, then yield and sleep.
+    BLOCK
+};
+
+// A memory access fed to the cache.
+struct MemoryAccess
+{
+    // Operation type.
+    Operation m_operation;
+
+    // Accessed address.
+    address_t m_address;
+
+    // Timestamp column of the input trace (a cycle or an instruction count), TIMESTAMP_MAX if it has none.
+    timestamp_t m_timestamp = TIMESTAMP_MAX;
+};
+
+// A range of addresses, [begin, end).
+struct AddressRange
+{
+    // First address of the range.
+    address_t m_begin;
+
+    // First address past the range.
+    address_t m_end;
+
+    // Whether an address is in the range.
+    bool Contains(address_t address) const { return address - m_begin < m_end - m_begin; }
 };
 
 // Utility function to check if a number is a power of two.
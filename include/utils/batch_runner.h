@@ -0,0 +1,96 @@
+/**
+ * @file      batch_runner.h
+ * @brief     Batch runner class definition. Simulates many input traces in one process.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <utils/config_reader.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class ResultStore;
+
+// Outcome of simulating one input trace.
+struct BatchResult
+{
+    // Input trace.
+    std::string m_input_file;
+
+    // Output trace.
+    std::string m_output_file;
+
+    // Size of the input trace.
+    std::uint64_t m_input_bytes = 0;
+
+    // Accesses in the input trace.
+    std::uint64_t m_loads = 0;
+    std::uint64_t m_stores = 0;
+
+    // Requests sent to main memory (fills and writebacks).
+    std::uint64_t m_dram_reads = 0;
+    std::uint64_t m_dram_writes = 0;
+
+    // Simulation time.
+    double m_seconds = 0;
+
+    // Worker that ran the job.
+    unsigned m_worker = 0;
+
+    // The output was reused from the result store instead of simulated.
+    bool m_reused = false;
+
+    // Error message. Empty on success.
+    std::string m_error;
+};
+
+class BatchRunner
+{
+public:
+    // Constructor. Every job simulates the cache of the configuration and writes to the output directory.
+    // With a result store directory, traces already simulated with the same cache are reused from it.
+    BatchRunner(Config const& config, std::string const& output_directory, unsigned threads, bool pin_threads, std::string const& result_store = "");
+
+    // Expand a directory (its *.trace files), a glob pattern, a single trace or a manifest (one trace per line) into input traces.
+    static std::vector<std::string> ExpandInputs(std::string const& inputs);
+
+    // Simulate every input trace, each with its own cache and output. Returns the results in input order.
+    std::vector<BatchResult> Run(std::vector<std::string> const& input_files);
+
+    // Print a summary of a run.
+    void PrintReport(std::ostream& stream, std::vector<BatchResult> const& results, double wall_seconds) const;
+
+    // Write the per-job results as CSV.
+    static void WriteReportCsv(std::string const& report_file, std::vector<BatchResult> const& results);
+
+    // Simulate one input trace, or reuse its stored result. Errors are recorded in the result.
+    static void RunJob(Config const& config, BatchResult& result, ResultStore const* store);
+private:
+    // Cache configuration shared by all jobs.
+    Config const c_config;
+
+    // Directory of the output traces.
+    std::string const c_output_directory;
+
+    // Amount of worker threads.
+    unsigned const c_thread_count;
+
+    // Bind each worker to a CPU.
+    bool const c_pin_threads;
+
+    // Result store directory. Empty disables the store.
+    std::string const c_result_store;
+};
+
+#endif // BATCH_RUNNER_H
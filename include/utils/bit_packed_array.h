@@ -0,0 +1,89 @@
+/**
+ * @file      bit_packed_array.h
+ * @brief     Fixed-width unsigned integers packed back to back in 64-bit words.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef BIT_PACKED_ARRAY_H
+#define BIT_PACKED_ARRAY_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+class BitPackedArray
+{
+public:
+    // Constructor. All elements start at zero.
+    BitPackedArray(std::size_t size, unsigned width) :
+            c_width(width),
+            c_mask(width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1),
+            m_words((size * width + 63) / 64 + 1)
+    {
+        if (width == 0 || width > 64)
+            throw std::invalid_argument("Packed element width must be between 1 and 64 bits.");
+    }
+
+    // Read an element.
+    std::uint64_t Get(std::size_t index) const
+    {
+        std::size_t const bit = index * c_width;
+        std::size_t const word = bit >> 6;
+        unsigned const offset = bit & 63;
+
+        std::uint64_t value = m_words[word] >> offset;
+
+        // The element straddles two words.
+        if (offset + c_width > 64)
+            value |= m_words[word + 1] << (64 - offset);
+
+        return value & c_mask;
+    }
+
+    // Write an element. Bits above the width are dropped.
+    void Set(std::size_t index, std::uint64_t value)
+    {
+        std::size_t const bit = index * c_width;
+        std::size_t const word = bit >> 6;
+        unsigned const offset = bit & 63;
+
+        value &= c_mask;
+        m_words[word] = (m_words[word] & ~(c_mask << offset)) | (value << offset);
+
+        // The element straddles two words.
+        if (offset + c_width > 64)
+        {
+            unsigned const spill = 64 - offset;
+            m_words[word + 1] = (m_words[word + 1] & ~(c_mask >> spill)) | (value >> spill);
+        }
+    }
+
+    // Prefetch the word holding the start of an element.
+    void Prefetch(std::size_t index) const
+    {
+        __builtin_prefetch(&m_words[(index * c_width) >> 6]);
+    }
+
+    // Bits per element.
+    unsigned GetWidth() const { return c_width; }
+
+    // Bytes of storage.
+    std::size_t GetBytes() const { return m_words.size() * sizeof(std::uint64_t); }
+private:
+    // Bits per element.
+    unsigned const c_width;
+
+    // Mask of the element bits.
+    std::uint64_t const c_mask;
+
+    // Storage, with a spare word so that straddling reads never go out of bounds.
+    std::vector<std::uint64_t> m_words;
+};
+
+#endif // BIT_PACKED_ARRAY_H
@@ -1,6 +1,6 @@
 /**
  * @file      clock.h
- * @brief     Global clock class definition.
+ * @brief     Simulation clock class definition.
  * @author    Victor Jimenez (victor.jimenez@colorado.edu)
  * @date      2025-11-25
  * 
@@ -16,22 +16,25 @@
 
 #include <typedefs.h>
 
-class GlobalClock
+// Each simulation instance owns its clock, so several instances can coexist in one process.
+class Clock
 {
 public:
+    // Constructor. The clock starts at cycle 1.
+    Clock() : m_cycle(1) {}
 
-    // Increment the Global Clock.
-    static void Increment();
+    // Increment the clock.
+    void Increment() { m_cycle++; }
 
-    // Reset the Global Clock.
-    static void Reset();
+    // Reset the clock.
+    void Reset() { m_cycle = 0; }
 
-    // Get the current cycle of the Global Clock.
-    static timestamp_t GetCycle();
+    // Get the current cycle of the clock.
+    timestamp_t GetCycle() const { return m_cycle; }
     
 private:
-    // Output file stream.
-    static timestamp_t m_cycle;
+    // Current cycle.
+    timestamp_t m_cycle;
 };
 
-#endif // CLOCK_H
\ No newline at end of file
+#endif // CLOCK_H
@@ -13,8 +13,61 @@
 #ifndef CONFIG_READER_H
 #define CONFIG_READER_H
 
+#include <typedefs.h>
+#include <utils/trace_format.h>
+
 #include <cstdint>
 #include <string>
+#include <vector>
+
+// Cache organizations.
+enum class CacheOrganization
+{
+    // Set-associative cache of lines.
+    SET_ASSOCIATIVE,
+
+    // Sectored cache: line_size-byte blocks filled and written back in sector_size-byte sectors.
+    SECTORED
+};
+
+// How physical frames are chosen for the pages touched for the first time.
+enum class PageAllocation
+{
+    // Consecutive frames, in first-touch order.
+    SEQUENTIAL,
+
+    // A seeded pseudo-random permutation of the frames.
+    RANDOM,
+
+    // Pages interleaved across NUMA nodes by page number, consecutive frames within a node.
+    NUMA
+};
+
+// Row-buffer policy of the DRAM analyzer.
+enum class DramPagePolicy
+{
+    // Rows stay open after an access, until another row of the bank is accessed.
+    OPEN,
+
+    // Banks are precharged after every access.
+    CLOSED
+};
+
+// Source of the issue cycle of every access, carried by the requests it causes.
+enum class IssueTiming
+{
+    // The position of the access in the trace, one access per cycle (the cache clock).
+    ACCESS,
+
+    // A core issuing accesses_per_cycle accesses per cycle.
+    RATE,
+
+    // The same core, with the timestamp column counting the instructions since the previous access.
+    INSTRUCTION_GAPS,
+
+    // The timestamp column of the trace, in cycles.
+    TRACE
+};
 
 struct Config
 {
@@ -24,34 +77,160 @@ struct Config
     // Amount of ways in the cache.
     std::size_t m_ways;
 
-    // Size of a line in the cache.
+    // Size of a line in the cache (of a block in sectored caches).
     std::size_t m_line_size;
 
+    // Cache organization.
+    CacheOrganization m_organization = CacheOrganization::SET_ASSOCIATIVE;
+
+    // Sector size of sectored caches.
+    std::size_t m_sector_size = 64;
+
+    // Address width. Sizes the tags of sectored caches.
+    unsigned m_address_bits = 48;
+
+    // Accesses decoded ahead to prefetch their set metadata. Zero processes the accesses one by one.
+    std::size_t m_prefetch_distance = DEFAULT_PREFETCH_DISTANCE;
+
+    // Back the set metadata of set-associative caches with transparent huge pages.
+    bool m_huge_pages = true;
+
+    // Accesses per epoch: a flush point follows every m_flush_interval accesses. Zero disables the epochs.
+    std::uint64_t m_flush_interval = 0;
+
+    // What the epochs and the FLUSH markers of the trace do.
+    FlushMode m_flush_mode = FlushMode::INVALIDATE;
+
+    // When stores reach memory.
+    WritePolicy m_write_policy = WritePolicy::WRITE_BACK;
+
+    // Fill the line on a store miss. Otherwise the store goes to memory and the cache is left untouched.
+    bool m_write_allocate = true;
+
+    // Every store is a streaming (non-temporal) store: it bypasses the cache and invalidates the cached line.
+    bool m_streaming_stores = false;
+
+    // Combine the requests to memory in a write-combining buffer.
+    bool m_write_combining = false;
+
+    // Lines the write-combining buffer holds.
+    std::size_t m_write_combining_entries = 16;
+
+    // Translate the virtual addresses of the trace to physical addresses before the cache.
+    bool m_translation = false;
+
+    // Page size of the translation: 4 KiB or 2 MiB.
+    std::size_t m_page_size = 4096;
+
+    // Frame allocation policy.
+    PageAllocation m_page_allocation = PageAllocation::SEQUENTIAL;
+
+    // Physical memory handed out as frames.
+    std::uint64_t m_physical_memory = std::uint64_t(64) << 30;
+
+    // NUMA nodes of the NUMA policy. The physical memory is split evenly among them.
+    std::size_t m_numa_nodes = 1;
+
+    // Seed of the random policy.
+    std::uint64_t m_translation_seed = 1;
+
+    // Entries of the software TLB (direct-mapped).
+    std::size_t m_tlb_entries = 64;
+
+    // Send the page-table loads of every TLB miss through the cache.
+    bool m_page_walks = false;
+
+    // Analyze the row-buffer locality and bank balance of the output requests.
+    bool m_dram_analyzer = false;
+
+    // DRAM organization: channels, ranks per channel, bank groups per rank and banks per bank group.
+    std::size_t m_dram_channels = 1;
+    std::size_t m_dram_ranks = 1;
+    std::size_t m_dram_bank_groups = 4;
+    std::size_t m_dram_banks = 4;
+
+    // Rows per bank and bytes per row.
+    std::size_t m_dram_rows = 65536;
+    std::size_t m_dram_row_size = 8192;
+
+    // Address mapping: two-letter fields (Ch, Ra, Bg, Ba, Ro, Co), most significant first.
+    std::string m_dram_mapping = "RoRaBgBaCoCh";
+
+    // Row-buffer policy.
+    DramPagePolicy m_dram_page_policy = DramPagePolicy::OPEN;
+
+    // Fold the low row bits into the bank and bank group bits.
+    bool m_dram_xor_banks = false;
+
+    // Requests per bank-level parallelism window.
+    std::uint64_t m_dram_window = 64;
+
+    // Issue cycle of the requests.
+    IssueTiming m_issue_timing = IssueTiming::ACCESS;
+
+    // Peak access rate of the issue-rate model.
+    double m_accesses_per_cycle = 1.0;
+
+    // Cycles per instruction of the instruction gaps.
+    double m_cycles_per_instruction = 1.0;
+
+    // Cycles from the issue of an access to its requests leaving the cache (all but ACCESS timing).
+    std::uint64_t m_hit_latency = 0;
+
+    // Measure only the region of interest, between the ROI_BEGIN and ROI_END markers of the input trace.
+    bool m_roi = false;
+
+    // Accesses fast-forwarded (not simulated), simulated without output (functional warmup), and measured (0 for all).
+    std::uint64_t m_skip_accesses = 0;
+    std::uint64_t m_warmup_accesses = 0;
+    std::uint64_t m_measure_accesses = 0;
+
+    // Address filter of the input: accesses inside an include range, if any, and outside every exclude range.
+    std::vector<AddressRange> m_include_ranges;
+    std::vector<AddressRange> m_exclude_ranges;
+
     // Path to the input trace file.
     std::string m_input_trace_file;
 
     // Path to the output trace file.
     std::string m_output_trace_file;
+
+    // Format of the output trace.
+    TraceFormat m_output_trace_format = TraceFormat::TEXT;
+
+    // Name of the shared-memory ring fed by a live tracer. Replaces the input trace file when set.
+    std::string m_input_shm_name;
+
+    // Lanes (concurrent tracer threads) of the ring.
+    std::uint32_t m_input_shm_lanes = 1;
+
+    // Records per lane.
+    std::uint64_t m_input_shm_capacity = 1 << 20;
+
+    // How to wait for the tracer.
+    WaitPolicy m_input_shm_wait = WaitPolicy::BLOCK;
 };
 
+// Stateless: every call works on the configuration it is given, so independent instances can coexist.
 class ConfigReader
 {
 public:
-    // Loads the configuration file.
-    static void Load(std::string const& config_file);
+    // Loads and validates a configuration file. Without require_io the [IO] section is optional (batch mode).
+    static Config Load(std::string const& config_file, bool require_io = true);
 
-    // Print the loaded configuration.
-    static void PrintConfig();
-
-    // Returns the loaded configuration.
-    static Config const& GetConfig();
-private:
-    // Configuration data.
-    static Config m_config;
+    // Print a configuration.
+    static void PrintConfig(Config const& config);
 
+    // Whether a configuration simulates only part of the input trace.
+    static bool HasRegion(Config const& config);
 
-    // Sanity check the loaded configuration.
-    static void ValidateConfig();
+    // Expand the [SWEEP] grid of a configuration file: one validated configuration per point, in grid order (the
+    // last key varies fastest). Swept keys take a value or a list of values; the others keep the value of the file.
+    // Every point needs an existing input trace. The output trace file is left to the caller.
+    static std::vector<Config> LoadSweep(std::string const& config_file);
+private:
+    // Sanity check a loaded configuration.
+    static void ValidateConfig(Config const& config, bool require_io);
 };
 
 #endif // CONFIG_READER_H
\ No newline at end of file
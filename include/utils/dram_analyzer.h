@@ -0,0 +1,142 @@
+/**
+ * @file      dram_analyzer.h
+ * @brief     DRAM analyzer class definition. Estimates row-buffer locality and bank balance of the output stream.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef DRAM_ANALYZER_H
+#define DRAM_ANALYZER_H
+
+#include <utils/config_reader.h>
+#include <utils/memory_sink.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Request counts of a bank.
+struct BankStats
+{
+    // Requests by operation.
+    std::uint64_t m_reads = 0;
+    std::uint64_t m_writes = 0;
+
+    // Requests to the open row, to a precharged bank, and to a bank with another row open.
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+    std::uint64_t m_conflicts = 0;
+};
+
+// Forwards every request to a target and, on the way, maps it to a channel, rank, bank and row of a DRAM
+// organization. Each bank keeps its open row: with the open-page policy a request to the open row is a
+// hit and one to another row a conflict; with the closed-page policy every request activates a precharged
+// bank. There is no timing: the order of the requests stands for the order at the DRAM. Bank-level
+// parallelism is estimated as the average amount of distinct banks in windows of consecutive requests.
+class DramAnalyzer final : public MemorySink
+{
+public:
+    // Address fields, in the two-letter names of the mapping string.
+    enum Field
+    {
+        CHANNEL,
+        RANK,
+        BANK_GROUP,
+        BANK,
+        ROW,
+        COLUMN,
+        FIELD_COUNT
+    };
+
+    // Constructor. The organization and mapping come from the configuration. Requests are forwarded to the target.
+    DramAnalyzer(Config const& config, MemorySink& target);
+
+    // Forward and analyze a request. Flush points are only forwarded.
+    void Send(MemoryRequest const& request) override
+    {
+        m_target.Send(request);
+
+        if (request.m_operation != FLUSH)
+            Record(request.m_operation, request.m_address);
+    }
+
+    // Print the row-buffer, bank and channel statistics.
+    void PrintReport(std::ostream& stream) const;
+
+    // Statistics of a bank. Banks are numbered channel by channel, then rank, bank group and bank.
+    BankStats const& GetBankStats(std::size_t bank) const { return m_banks[bank]; }
+
+    // Amount of banks over all channels and ranks.
+    std::size_t GetBankCount() const { return m_banks.size(); }
+private:
+    // Position and width of an address field.
+    struct FieldLayout
+    {
+        unsigned m_shift;
+        unsigned m_bits;
+    };
+
+    // Destination of the requests.
+    MemorySink& m_target;
+
+    // Mapping string, most significant field first.
+    std::string const c_mapping;
+
+    // Field sizes.
+    std::size_t const c_sizes[FIELD_COUNT];
+
+    // Address bits below the column: the request size.
+    unsigned const c_offset_bits;
+
+    // Keep rows open after an access.
+    bool const c_open_page;
+
+    // Fold the low row bits into the bank and bank group bits.
+    bool const c_xor_banks;
+
+    // Requests per bank-level parallelism window.
+    std::uint64_t const c_window;
+
+
+    // Layout of each field.
+    FieldLayout m_fields[FIELD_COUNT];
+
+    // Bits covered by the mapping. Address bits above them extend the row.
+    unsigned m_mapped_bits;
+
+    // Open row of each bank. ~0 for a precharged bank.
+    std::vector<std::uint64_t> m_open_rows;
+
+    // Per-bank statistics.
+    std::vector<BankStats> m_banks;
+
+    // Banks touched in the current window, as a bitmap, and requests left in it.
+    std::vector<std::uint64_t> m_window_banks;
+    std::uint64_t m_window_remaining;
+
+    // Sum of distinct banks over the completed windows, and amount of completed windows.
+    std::uint64_t m_window_bank_sum;
+    std::uint64_t m_window_count;
+
+
+    // Value of a field of an address.
+    std::uint64_t Extract(address_t const address, Field const field) const
+    {
+        FieldLayout const& layout = m_fields[field];
+        return (address >> layout.m_shift) & ((std::uint64_t(1) << layout.m_bits) - 1);
+    }
+
+    // Map and account a request.
+    void Record(Operation const operation, address_t const address);
+
+    // Close the current bank-level parallelism window.
+    void CloseWindow();
+};
+
+#endif // DRAM_ANALYZER_H
@@ -0,0 +1,47 @@
+/**
+ * @file      mapped_arena.h
+ * @brief     Mapped arena class definition. A large zero-filled region that is only backed once touched.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef MAPPED_ARENA_H
+#define MAPPED_ARENA_H
+
+#include <cstddef>
+
+// An anonymous private mapping reserved without swap accounting (MAP_NORESERVE), optionally advised for
+// transparent huge pages. Mapping it is O(1) whatever its size: the kernel hands out zero-filled pages
+// on first touch, so resident memory follows the pages actually used (2 MiB ones with huge pages).
+class MappedArena
+{
+public:
+    // Constructor. Maps the given amount of bytes.
+    MappedArena(std::size_t size, bool huge_pages);
+
+    // Destructor. Unmaps the region.
+    ~MappedArena();
+
+    // The arena owns its mapping.
+    MappedArena(MappedArena const&) = delete;
+    MappedArena& operator=(MappedArena const&) = delete;
+
+    // Start of the region, aligned to a page.
+    char* GetBase() const { return m_base; }
+
+    // Size of the region.
+    std::size_t GetSize() const { return c_size; }
+private:
+    // Bytes mapped.
+    std::size_t const c_size;
+
+    // Start of the mapping.
+    char* m_base;
+};
+
+#endif // MAPPED_ARENA_H
@@ -0,0 +1,105 @@
+/**
+ * @file      memory_sink.h
+ * @brief     Memory sink interface. Receives the requests that the cache issues to main memory.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ * 
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ * 
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef MEMORY_SINK_H
+#define MEMORY_SINK_H
+
+#include <typedefs.h>
+
+#include <functional>
+#include <utility>
+
+// A request issued to main memory.
+struct MemoryRequest
+{
+    // Operation type: LOAD for fills, STORE for writebacks.
+    Operation m_operation;
+
+    // Line address.
+    address_t m_address;
+
+    // Cycle of the access that issued the request.
+    timestamp_t m_cycle;
+};
+
+class MemorySink
+{
+public:
+    // Virtual destructor for derived sinks.
+    virtual ~MemorySink() = default;
+
+    // Receive a request.
+    virtual void Send(MemoryRequest const& request) = 0;
+
+    // Record a load (line fill).
+    void Load(address_t const address, timestamp_t const cycle) { Send({LOAD, address, cycle}); }
+
+    // Record a store (writeback).
+    void Store(address_t const address, timestamp_t const cycle) { Send({STORE, address, cycle}); }
+};
+
+// Forwards every request to a user-supplied callback. Used to embed the simulator in other tools.
+class CallbackSink : public MemorySink
+{
+public:
+    // Callback type.
+    using Callback = std::function<void(MemoryRequest const&)>;
+
+    // Constructor. Stores the callback.
+    explicit CallbackSink(Callback callback) : m_callback(std::move(callback)) {}
+
+    // Forward a request to the callback.
+    void Send(MemoryRequest const& request) override { m_callback(request); }
+private:
+    // User callback.
+    Callback m_callback;
+};
+
+// Counts requests and discards them.
+class CountingSink : public MemorySink
+{
+public:
+    // Count a request.
+    void Send(MemoryRequest const& request) override { ++(request.m_operation == STORE ? m_stores : m_loads); }
+
+    // Loads received.
+    std::uint64_t m_loads = 0;
+
+    // Stores received.
+    std::uint64_t m_stores = 0;
+};
+
+// Forwards requests to a target only while open. Used to warm a cache up without recording its requests.
+class GatedSink : public MemorySink
+{
+public:
+    // Constructor. The gate starts closed.
+    explicit GatedSink(MemorySink& target) : m_target(target), m_open(false) {}
+
+    // Forward a request if the gate is open.
+    void Send(MemoryRequest const& request) override
+    {
+        if (m_open)
+            m_target.Send(request);
+    }
+
+    // Open or close the gate.
+    void SetOpen(bool open) { m_open = open; }
+private:
+    // Destination of the requests.
+    MemorySink& m_target;
+
+    // Forward requests.
+    bool m_open;
+};
+
+#endif // MEMORY_SINK_H
@@ -0,0 +1,164 @@
+/**
+ * @file      pipeline_runner.h
+ * @brief     Pipeline runner class definition. Reads, simulates and writes a trace on three threads.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef PIPELINE_RUNNER_H
+#define PIPELINE_RUNNER_H
+
+#include <core/cache_model.h>
+#include <utils/memory_sink.h>
+#include <utils/spsc_queue.h>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <vector>
+
+// Time a pipeline stage spent running and waiting on its queues.
+struct StageStats
+{
+    // CPU the stage was pinned to, -1 if unpinned.
+    int m_cpu = -1;
+
+    // From the start of the stage to its end.
+    double m_seconds = 0;
+
+    // Waiting for the previous stage (empty input queue).
+    double m_starved_seconds = 0;
+
+    // Waiting for the next stage (full output queue).
+    double m_blocked_seconds = 0;
+};
+
+// Outcome of a pipelined run.
+struct PipelineStats
+{
+    // Accesses read, by operation.
+    std::uint64_t m_loads = 0;
+    std::uint64_t m_stores = 0;
+
+    // Stages, in pipeline order.
+    StageStats m_reader;
+    StageStats m_cache;
+    StageStats m_writer;
+};
+
+// Runs the reader, the cache and the writer on their own threads, connected by bounded SPSC queues of
+// batches. The reader decodes accesses, the cache simulates them and the writer hands the requests to the
+// final sink (formatting and writing the output trace). Each stage only waits when its input queue is empty
+// or its output queue full, and the waiting time is reported: the stage that waits the least limits the
+// throughput. Requests keep their order, so the output is identical to the sequential run. Single use.
+class PipelineRunner
+{
+public:
+    // Source of accesses: fills up to max_count accesses, returns the amount, 0 at the end of the input.
+    using Source = std::function<std::size_t(MemoryAccess* accesses, std::size_t max_count)>;
+
+    // Constructor. Pinned stages are bound to one allowed CPU each.
+    explicit PipelineRunner(bool pin_threads);
+
+    // Sink the cache must send its requests to. They reach the final sink from the writer thread.
+    MemorySink& GetCacheSink() { return m_cache_sink; }
+
+    // Simulate the whole source, then flush the cache. Returns once every request reached the target.
+    // The first exception of any stage stops the pipeline and is rethrown.
+    PipelineStats Run(Source const& source, CacheModel& cache, MemorySink& target);
+
+    // Print the time of every stage and the stage that limits the throughput.
+    static void PrintReport(std::ostream& stream, PipelineStats const& stats);
+private:
+    // A batch of accesses, read by the reader for the cache. An empty batch ends the stream.
+    struct AccessBatch
+    {
+        // Room for a full batch, and the amount filled.
+        std::vector<MemoryAccess> m_accesses;
+        std::size_t m_count = 0;
+    };
+
+    // A batch of requests, issued by the cache for the writer. An empty batch ends the stream.
+    struct RequestBatch
+    {
+        // Room for a full batch, and the amount filled.
+        std::vector<MemoryRequest> m_requests;
+        std::size_t m_count = 0;
+    };
+
+    // Thrown inside a stage when another stage failed.
+    struct Aborted {};
+
+    // Collects the requests of the cache into batches of the request queue.
+    class QueueSink final : public MemorySink
+    {
+    public:
+        // Constructor.
+        explicit QueueSink(PipelineRunner& runner) : m_runner(runner), m_batch(nullptr) {}
+
+        // Append a request to the current batch, publishing it once full.
+        void Send(MemoryRequest const& request) override
+        {
+            m_batch->m_requests[m_batch->m_count++] = request;
+
+            if (m_batch->m_count == m_batch->m_requests.size())
+                Publish();
+        }
+
+        // Take the first batch. Called by the cache stage before simulating.
+        void Open();
+
+        // Publish the current batch and take the next one.
+        void Publish();
+
+        // Publish the pending requests and the end of the stream.
+        void Close();
+    private:
+        // Owner of the queue.
+        PipelineRunner& m_runner;
+
+        // Batch being filled.
+        RequestBatch* m_batch;
+    };
+
+    // Bind the stages to CPUs.
+    bool const c_pin_threads;
+
+
+    // Reader to cache.
+    SpscQueue<AccessBatch> m_access_queue;
+
+    // Cache to writer.
+    SpscQueue<RequestBatch> m_request_queue;
+
+    // Sink handed to the cache.
+    QueueSink m_cache_sink;
+
+    // Timing of every stage.
+    PipelineStats m_stats;
+
+    // Set when a stage failed. The others stop at their next wait.
+    std::atomic<bool> m_aborted;
+
+    // First exception of a stage.
+    std::exception_ptr m_error;
+    std::mutex m_error_mutex;
+
+
+    // Run a stage on the calling thread: pin it, time it and record its exception, if any.
+    void RunStage(StageStats& stats, unsigned index, std::function<void()> const& body);
+
+    // Retry an operation on a queue until it returns a slot, adding the waiting time to a counter.
+    template <typename TryOperation>
+    auto WaitFor(TryOperation const& operation, double& stall_seconds) -> decltype(operation());
+};
+
+#endif // PIPELINE_RUNNER_H
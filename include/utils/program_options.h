@@ -13,8 +13,18 @@
 #ifndef PROGRAM_OPTIONS_H
 #define PROGRAM_OPTIONS_H
 
+#include <cstdint>
 #include <string>
 
+// Step of a sweep run by this process.
+enum class SweepStep
+{
+    NONE,
+    PLAN,
+    WORK,
+    MERGE
+};
+
 class ProgramOptions
 {
 public:
@@ -25,6 +35,40 @@ public:
     // Configuration file path.
     std::string m_config_file;
 
+    // Batch mode inputs: a directory, a glob pattern or a manifest. Empty for a single run.
+    std::string m_batch_inputs;
+
+    // Directory of the batch output traces.
+    std::string m_batch_output_directory;
+
+    // Batch report file. Defaults to batch_report.csv in the output directory.
+    std::string m_batch_report_file;
+
+    // Worker threads of the batch and time-sliced modes. 0 uses one per allowed CPU.
+    unsigned m_batch_threads;
+
+    // Time slices of the input trace simulated in parallel. 0 for an exact, sequential run.
+    std::size_t m_slices;
+
+    // Accesses replayed before each time slice to warm the cache up.
+    std::uint64_t m_slice_warmup;
+
+    // Also run the exact simulation and report the error of the time slices.
+    bool m_verify_slices;
+
+    // Bind each worker to a CPU.
+    bool m_pin_threads;
+
+    // Read, simulate and write on three pipelined threads.
+    bool m_pipeline;
+
+    // Sweep step, and the sweep directory it works on.
+    SweepStep m_sweep_step;
+    std::string m_sweep_directory;
+
+    // Result store directory. Runs already simulated are reused from it. Empty disables the store.
+    std::string m_result_store;
+
     // Flag indicating whether the program should exit after displaying help or version info.
     bool m_should_exit;
 private:
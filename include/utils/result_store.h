@@ -0,0 +1,64 @@
+/**
+ * @file      result_store.h
+ * @brief     Result store class definition. Reuses the outputs of runs already simulated.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef RESULT_STORE_H
+#define RESULT_STORE_H
+
+#include <utils/config_reader.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Statistics of a completed run, stored next to its output trace.
+struct RunStats
+{
+    // Accesses in the input trace.
+    std::uint64_t m_loads = 0;
+    std::uint64_t m_stores = 0;
+
+    // Requests sent to main memory (fills and writebacks).
+    std::uint64_t m_dram_reads = 0;
+    std::uint64_t m_dram_writes = 0;
+
+    // Simulation time of the run that produced the result.
+    double m_seconds = 0;
+};
+
+// A directory of completed runs, one entry per fingerprint: <directory>/<hash>/{key, stats, output.trace}.
+// The fingerprint covers the input trace (size, modification time and a sampled content hash), the settings
+// that change the output, and the simulator version. An entry is built in a temporary directory and renamed
+// into place, so readers only ever see complete entries. Outputs are hard-linked in both directions when the
+// store and the output share a file system, and copied otherwise.
+class ResultStore
+{
+public:
+    // Constructor. Creates the directory if needed.
+    explicit ResultStore(std::string const& directory);
+
+    // Fingerprint of simulating an input trace with a configuration. Human-readable, one field per line.
+    static std::string Fingerprint(std::string const& input_file, Config const& config);
+
+    // Reuse a stored result: place its output trace at output_file and load its statistics. False on a miss.
+    bool Fetch(std::string const& fingerprint, std::string const& output_file, RunStats& stats) const;
+
+    // Store the result of a completed run. Keeps the entry already stored by a concurrent run, if any.
+    void Store(std::string const& fingerprint, std::string const& output_file, RunStats const& stats) const;
+
+    // Directory of the entry of a fingerprint.
+    std::string GetEntryPath(std::string const& fingerprint) const;
+private:
+    // Store directory.
+    std::filesystem::path const c_directory;
+};
+
+#endif // RESULT_STORE_H
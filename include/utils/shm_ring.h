@@ -0,0 +1,393 @@
+/**
+ * @file      shm_ring.h
+ * @brief     Shared-memory ring of binary memory accesses. Layout shared by T-Bridge and live tracers,
+ *            plus the producer side. Self-contained so that tool writers can drop it into their tracer.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+// Usage (producer side, e.g. inside a Pin or DynamoRIO client):
+//
+//     ShmRingProducer producer("/tbridge");     // Attach to the ring created by T-Bridge.
+//     ShmRingWriter writer(producer);           // One writer per instrumented thread.
+//
+//     writer.Load(address);
+//     writer.Store(address);
+//
+//     writer.Close();                           // Publish the remaining records.
+//     producer.Finish();                        // No more records: T-Bridge finishes the simulation.
+//
+// The segment holds one single-producer/single-consumer lane per writer. Writers never share
+// cache lines, and T-Bridge drains the lanes round-robin in batches.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shm_ring
+{
+    // Segment signature ("TBRSHM01"). Written last by the creator.
+    constexpr std::uint64_t c_magic = 0x31304d4853524254ull;
+
+    // Layout version.
+    constexpr std::uint32_t c_version = 2;
+
+    // Cache line size used to keep producer and consumer indices apart.
+    constexpr std::size_t c_cache_line = 64;
+
+    // Bit of a record that flags a store. The remaining bits hold the address.
+    constexpr std::uint64_t c_store_bit = 1ull << 63;
+
+    // Records a writer accumulates before making them visible to the consumer.
+    constexpr std::uint64_t c_publish_batch = 64;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The ring requires lock-free 64-bit atomics.");
+
+    // Segment header. Placed at offset 0.
+    struct alignas(c_cache_line) Header
+    {
+        // Segment signature. Valid once it equals c_magic.
+        std::atomic<std::uint64_t> m_magic;
+
+        // Layout version.
+        std::uint32_t m_version;
+
+        // Amount of lanes.
+        std::uint32_t m_lanes;
+
+        // Records per lane. Power of two.
+        std::uint64_t m_capacity;
+
+        // Lanes handed out to writers.
+        std::atomic<std::uint32_t> m_claimed_lanes;
+
+        // Set by the producer once every writer is closed.
+        std::atomic<std::uint32_t> m_finished;
+
+        // Process id of the producer, used to detect a tracer that died without finishing.
+        std::atomic<std::int32_t> m_producer_pid;
+
+        // Process id of the consumer, used to skip segments left behind by a crashed simulator.
+        std::int32_t m_consumer_pid;
+
+        // Set by the consumer once it stops draining the lanes.
+        std::atomic<std::uint32_t> m_consumer_closed;
+    };
+
+    // Whether the consumer of a segment stopped draining it, by closing the ring or by dying.
+    inline bool IsConsumerGone(Header const* header)
+    {
+        return header->m_consumer_closed.load(std::memory_order_acquire) != 0 || (kill(header->m_consumer_pid, 0) == -1 && errno == ESRCH);
+    }
+
+    // Lane control block. The producer and consumer indices live on separate cache lines.
+    struct Lane
+    {
+        // Records published by the producer.
+        alignas(c_cache_line) std::atomic<std::uint64_t> m_head;
+
+        // Records consumed by the consumer.
+        alignas(c_cache_line) std::atomic<std::uint64_t> m_tail;
+    };
+
+    // Bytes of a segment.
+    inline std::size_t SegmentSize(std::uint32_t lanes, std::uint64_t capacity)
+    {
+        return sizeof(Header) + lanes * sizeof(Lane) + lanes * capacity * sizeof(std::uint64_t);
+    }
+
+    // Control block of a lane.
+    inline Lane* GetLane(void* base, std::uint32_t lane)
+    {
+        return reinterpret_cast<Lane*>(static_cast<char*>(base) + sizeof(Header)) + lane;
+    }
+
+    // Records of a lane.
+    inline std::uint64_t* GetRecords(void* base, std::uint32_t lanes, std::uint64_t capacity, std::uint32_t lane)
+    {
+        char* const records = static_cast<char*>(base) + sizeof(Header) + lanes * sizeof(Lane);
+        return reinterpret_cast<std::uint64_t*>(records) + lane * capacity;
+    }
+
+    // Encode an access into a record.
+    inline std::uint64_t Encode(bool is_store, std::uint64_t address)
+    {
+        return (address & ~c_store_bit) | (is_store ? c_store_bit : 0);
+    }
+
+    // Hint the processor that we are busy-waiting.
+    inline void CpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // Waiting strategy for an empty (consumer) or full (producer) lane. Spins first, then yields,
+    // then sleeps with an exponential backoff. A spin-only backoff never gives up the core.
+    class Backoff
+    {
+    public:
+        // Constructor.
+        explicit Backoff(bool spin_only = false) : m_spin_only(spin_only) {}
+
+        // Wait once. Returns true every now and then, a good moment for slow checks.
+        bool Wait()
+        {
+            ++m_rounds;
+
+            if (m_spin_only || m_rounds < c_spin_rounds)
+            {
+                CpuRelax();
+                return (m_rounds & c_check_mask) == 0;
+            }
+
+            if (m_rounds < c_yield_rounds)
+            {
+                std::this_thread::yield();
+                return false;
+            }
+
+            std::this_thread::sleep_for(m_sleep);
+            m_sleep = std::min(m_sleep * 2, c_max_sleep);
+            return true;
+        }
+
+        // Start over after progress.
+        void Reset()
+        {
+            m_rounds = 0;
+            m_sleep = c_min_sleep;
+        }
+    private:
+        // Busy-wait rounds before yielding.
+        static constexpr std::uint64_t c_spin_rounds = 1024;
+
+        // Rounds before sleeping.
+        static constexpr std::uint64_t c_yield_rounds = 1024 + 64;
+
+        // Spinning rounds between slow checks.
+        static constexpr std::uint64_t c_check_mask = (1 << 20) - 1;
+
+        // Sleep bounds.
+        static constexpr std::chrono::microseconds c_min_sleep{10};
+        static constexpr std::chrono::microseconds c_max_sleep{1000};
+
+        // Never sleep or yield.
+        bool const m_spin_only;
+
+        // Rounds waited since the last progress.
+        std::uint64_t m_rounds = 0;
+
+        // Next sleep.
+        std::chrono::microseconds m_sleep = c_min_sleep;
+    };
+}
+
+class ShmRingProducer
+{
+public:
+    // Constructor. Attaches to the segment created by T-Bridge, retrying until it appears or the timeout expires.
+    explicit ShmRingProducer(std::string const& name, std::chrono::milliseconds timeout = std::chrono::seconds(30))
+    {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        shm_ring::Backoff backoff;
+
+        while (true)
+        {
+            if (TryAttach(name))
+                break;
+
+            if (std::chrono::steady_clock::now() > deadline)
+                throw std::runtime_error("ShmRingProducer Error: No T-Bridge ring named " + name + " appeared in time.");
+
+            backoff.Wait();
+        }
+
+        if (m_header->m_version != shm_ring::c_version)
+            throw std::runtime_error("ShmRingProducer Error: Ring " + name + " has an unsupported layout version.");
+
+        m_header->m_producer_pid.store(static_cast<std::int32_t>(getpid()), std::memory_order_relaxed);
+    }
+
+    // Destructor. Finishes the stream and detaches.
+    ~ShmRingProducer()
+    {
+        Finish();
+        munmap(m_base, m_size);
+    }
+
+    ShmRingProducer(ShmRingProducer const&) = delete;
+    ShmRingProducer& operator=(ShmRingProducer const&) = delete;
+
+    // Signal the end of the stream. Every writer must be closed before.
+    void Finish()
+    {
+        m_header->m_finished.store(1, std::memory_order_release);
+    }
+
+    // Base address of the mapping.
+    void* GetBase() const { return m_base; }
+
+    // Segment header.
+    shm_ring::Header* GetHeader() const { return m_header; }
+private:
+    // Mapping of the segment.
+    void* m_base = nullptr;
+
+    // Bytes mapped.
+    std::size_t m_size = 0;
+
+    // Segment header.
+    shm_ring::Header* m_header = nullptr;
+
+
+    // Map the segment if it exists and is initialized.
+    bool TryAttach(std::string const& name)
+    {
+        int const fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd == -1)
+            return false;
+
+        struct stat sb;
+        if (fstat(fd, &sb) == -1 || static_cast<std::size_t>(sb.st_size) < sizeof(shm_ring::Header))
+        {
+            close(fd);
+            return false;
+        }
+
+        void* const base = mmap(nullptr, sb.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (base == MAP_FAILED)
+            throw std::runtime_error("ShmRingProducer Error: mmap failed for ring " + name + ": " + std::strerror(errno));
+
+        // Wait for the creator to initialize the segment. A segment whose creator is gone is stale.
+        auto* const header = static_cast<shm_ring::Header*>(base);
+        if (header->m_magic.load(std::memory_order_acquire) != shm_ring::c_magic || shm_ring::IsConsumerGone(header))
+        {
+            munmap(base, sb.st_size);
+            return false;
+        }
+
+        m_base = base;
+        m_size = sb.st_size;
+        m_header = header;
+        return true;
+    }
+};
+
+class ShmRingWriter
+{
+public:
+    // Constructor. Claims a lane of the ring. Each writer must be used by a single thread.
+    explicit ShmRingWriter(ShmRingProducer& producer)
+    {
+        shm_ring::Header* const header = producer.GetHeader();
+        m_header = header;
+
+        std::uint32_t const lane = header->m_claimed_lanes.fetch_add(1, std::memory_order_relaxed);
+        if (lane >= header->m_lanes)
+            throw std::runtime_error("ShmRingWriter Error: All " + std::to_string(header->m_lanes) + " lanes of the ring are in use.");
+
+        m_lane = shm_ring::GetLane(producer.GetBase(), lane);
+        m_records = shm_ring::GetRecords(producer.GetBase(), header->m_lanes, header->m_capacity, lane);
+        m_capacity = header->m_capacity;
+        m_head = m_published = m_lane->m_head.load(std::memory_order_relaxed);
+        m_cached_tail = m_lane->m_tail.load(std::memory_order_acquire);
+    }
+
+    // Destructor. Publishes the pending records.
+    ~ShmRingWriter() { Close(); }
+
+    ShmRingWriter(ShmRingWriter const&) = delete;
+    ShmRingWriter& operator=(ShmRingWriter const&) = delete;
+
+    // Append a load.
+    void Load(std::uint64_t address) { Write(false, address); }
+
+    // Append a store.
+    void Store(std::uint64_t address) { Write(true, address); }
+
+    // Append an access. Waits while the lane is full, and throws if the consumer stops draining it.
+    void Write(bool is_store, std::uint64_t address)
+    {
+        if (m_head - m_cached_tail == m_capacity)
+            WaitForSpace();
+
+        m_records[m_head & (m_capacity - 1)] = shm_ring::Encode(is_store, address);
+
+        if (++m_head - m_published >= shm_ring::c_publish_batch)
+            Flush();
+    }
+
+    // Make the appended records visible to the consumer.
+    void Flush()
+    {
+        m_lane->m_head.store(m_head, std::memory_order_release);
+        m_published = m_head;
+    }
+
+    // Publish the pending records. The writer must not be used afterwards.
+    void Close() { Flush(); }
+private:
+    // Segment header.
+    shm_ring::Header* m_header;
+
+    // Control block of the lane.
+    shm_ring::Lane* m_lane;
+
+    // Records of the lane.
+    std::uint64_t* m_records;
+
+    // Records per lane.
+    std::uint64_t m_capacity;
+
+    // Records appended.
+    std::uint64_t m_head;
+
+    // Records visible to the consumer.
+    std::uint64_t m_published;
+
+    // Last consumer position seen. Avoids touching the consumer's cache line on every write.
+    std::uint64_t m_cached_tail;
+
+
+    // Wait until the consumer frees a record. A consumer that is gone never will: fail instead of hanging the tracer.
+    void WaitForSpace()
+    {
+        // The consumer can only make progress on published records.
+        Flush();
+
+        shm_ring::Backoff backoff;
+        while ((m_cached_tail = m_lane->m_tail.load(std::memory_order_acquire)) + m_capacity == m_head)
+        {
+            if (backoff.Wait() && shm_ring::IsConsumerGone(m_header))
+                throw std::runtime_error("ShmRingWriter Error: T-Bridge (pid " + std::to_string(m_header->m_consumer_pid) + ") stopped reading the ring.");
+        }
+    }
+};
+
+#endif // SHM_RING_H
@@ -0,0 +1,85 @@
+/**
+ * @file      shm_trace_reader.h
+ * @brief     Shared-memory trace reader class definition. Consumes binary accesses from a live tracer.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SHM_TRACE_READER_H
+#define SHM_TRACE_READER_H
+
+#include <typedefs.h>
+#include <utils/shm_ring.h>
+
+#include <string>
+#include <vector>
+
+class ShmTraceReader
+{
+public:
+    // Constructor. Creates the shared-memory ring that the tracer attaches to (see shm_ring.h).
+    ShmTraceReader(std::string const& name, std::uint32_t lanes, std::uint64_t capacity, WaitPolicy wait_policy);
+
+    // Destructor. Closes, unmaps and removes the ring.
+    ~ShmTraceReader();
+
+    ShmTraceReader(ShmTraceReader const&) = delete;
+    ShmTraceReader& operator=(ShmTraceReader const&) = delete;
+
+    // Retrieves the next memory access. Waits for the tracer; returns false once it has finished.
+    bool GetNextAccess(Operation& op_type, address_t& address);
+
+    // Retrieves up to max_count accesses. Waits for the tracer; returns 0 once it has finished.
+    std::size_t GetNextAccesses(MemoryAccess* accesses, std::size_t max_count);
+private:
+    // Accesses buffered for GetNextAccess.
+    static constexpr std::size_t c_buffer_size = 4096;
+
+    // Name of the ring.
+    std::string const c_name;
+
+    // Amount of lanes.
+    std::uint32_t const c_lanes;
+
+    // Records per lane.
+    std::uint64_t const c_capacity;
+
+    // How to wait for the tracer.
+    WaitPolicy const c_wait_policy;
+
+    // Mapping of the segment.
+    void* m_base;
+
+    // Bytes mapped.
+    std::size_t m_size;
+
+    // Segment header.
+    shm_ring::Header* m_header;
+
+    // Next lane to drain.
+    std::uint32_t m_next_lane;
+
+    // Accesses buffered for GetNextAccess.
+    std::vector<MemoryAccess> m_buffer;
+
+    // Position and amount of buffered accesses.
+    std::size_t m_buffer_position;
+    std::size_t m_buffer_count;
+
+
+    // Drain up to max_count accesses from the first non-empty lane. Returns the amount drained.
+    std::size_t Drain(MemoryAccess* accesses, std::size_t max_count);
+
+    // Throw if the tracer died without finishing the stream.
+    void CheckProducer() const;
+
+    // Whether an existing segment was left behind by a consumer that is gone.
+    static bool IsStale(std::string const& name);
+};
+
+#endif // SHM_TRACE_READER_H
@@ -0,0 +1,64 @@
+/**
+ * @file      simulation.h
+ * @brief     Simulation building blocks shared by the single, batch and sweep runs.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-19
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <core/cache_model.h>
+#include <utils/config_reader.h>
+#include <utils/dram_analyzer.h>
+#include <utils/memory_sink.h>
+#include <utils/trace_reader.h>
+#include <utils/write_combining_buffer.h>
+
+#include <memory>
+
+// Path of the memory requests from a cache to their destination, usually a Trace Engine, with the stages the
+// configuration enables:
+//
+//     cache -> [write-combining buffer] -> [DRAM analyzer] -> destination
+//
+// Every mode that simulates a configuration builds it here, so that they all produce the same output.
+class SinkChain
+{
+public:
+    // Constructor. Without analysis, the DRAM analyzer is left out: it only adds a report.
+    SinkChain(Config const& config, MemorySink& destination, bool analyze);
+
+    // Where the requests of the cache enter the chain.
+    MemorySink& GetSink() { return *m_sink; }
+
+    // Forward the requests still held by the write-combining buffer. Must be called once the cache is flushed.
+    void Drain();
+
+    // Write-combining buffer. Null if disabled.
+    WriteCombiningBuffer* GetWriteCombining() const { return m_write_combining.get(); }
+
+    // DRAM analyzer. Null if disabled.
+    DramAnalyzer* GetAnalyzer() const { return m_analyzer.get(); }
+private:
+    // Analyzes the requests on their way to the destination.
+    std::unique_ptr<DramAnalyzer> m_analyzer;
+
+    // Combines the requests in front of memory.
+    std::unique_ptr<WriteCombiningBuffer> m_write_combining;
+
+    // First stage of the chain.
+    MemorySink* m_sink;
+};
+
+// Restrict a trace to the [REGION] of a configuration, if it has one: filter the addresses, fast-forward to the
+// warmup, run the warmup accesses through the cache, open the warmup gate (if any) and leave the reader on the
+// measured accesses. Unless quiet, the amount of skipped and warmup lines is printed.
+void EnterRegion(Config const& config, TraceReader& trace_reader, CacheModel& cache, GatedSink* warmup_gate, bool quiet);
+
+#endif // SIMULATION_H
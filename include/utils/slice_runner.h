@@ -0,0 +1,91 @@
+/**
+ * @file      slice_runner.h
+ * @brief     Slice runner class definition. Simulates one trace as time slices in parallel (approximate).
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SLICE_RUNNER_H
+#define SLICE_RUNNER_H
+
+#include <utils/config_reader.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Outcome of simulating one time slice.
+struct SliceResult
+{
+    // Bytes of the input trace simulated by the slice, [m_begin, m_end).
+    std::size_t m_begin = 0;
+    std::size_t m_end = 0;
+
+    // Start of the warmup replay.
+    std::size_t m_warmup_begin = 0;
+
+    // Accesses replayed to warm the cache up, and accesses simulated.
+    std::uint64_t m_warmup_accesses = 0;
+    std::uint64_t m_accesses = 0;
+
+    // Requests sent to main memory (fills and writebacks).
+    std::uint64_t m_dram_reads = 0;
+    std::uint64_t m_dram_writes = 0;
+
+    // Requests of the same accesses in the exact (sequential) run. Only set when verifying.
+    std::uint64_t m_exact_dram_reads = 0;
+    std::uint64_t m_exact_dram_writes = 0;
+
+    // Simulation time, warmup included.
+    double m_seconds = 0;
+};
+
+// The trace is cut into contiguous slices at line starts. Each slice runs on its own cache after replaying
+// the preceding warmup accesses with the requests discarded, and the slice outputs are concatenated in order.
+// Only the last slice flushes the cache, like the sequential run. The result is approximate: a slice starts
+// from the state left by its warmup window instead of by the whole trace before it.
+class SliceRunner
+{
+public:
+    // Constructor. The input and output traces come from the configuration.
+    SliceRunner(Config const& config, std::size_t slices, std::uint64_t warmup_accesses, unsigned threads, bool pin_threads);
+
+    // Simulate the slices and write the concatenated output trace. Returns the results in trace order.
+    std::vector<SliceResult> Run();
+
+    // Simulate the whole trace sequentially without output, and store the exact requests of every slice.
+    void Verify(std::vector<SliceResult>& results) const;
+
+    // Print a summary of a run. The error columns are printed after Verify.
+    void PrintReport(std::ostream& stream, std::vector<SliceResult> const& results, double wall_seconds, bool verified) const;
+private:
+    // Cache and trace configuration.
+    Config const c_config;
+
+    // Amount of slices.
+    std::size_t const c_slice_count;
+
+    // Accesses replayed before each slice.
+    std::uint64_t const c_warmup_accesses;
+
+    // Amount of worker threads.
+    unsigned const c_thread_count;
+
+    // Bind each worker to a CPU.
+    bool const c_pin_threads;
+
+
+    // Simulate one slice into its own output file.
+    void RunSlice(SliceResult& result, std::string const& output_file, bool last) const;
+
+    // Output file of a slice.
+    std::string SliceOutputFile(std::size_t slice) const;
+};
+
+#endif // SLICE_RUNNER_H
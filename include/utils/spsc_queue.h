@@ -0,0 +1,103 @@
+/**
+ * @file      spsc_queue.h
+ * @brief     Bounded lock-free single-producer/single-consumer queue of preallocated slots.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <typedefs.h>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Slots are filled and drained in place: the producer writes into the slot at the head and publishes it,
+// the consumer reads the slot at the tail and releases it. Nothing is copied through the queue, so slots
+// can be whole batches. A full queue refuses new slots, which is the backpressure of the producer.
+template <typename T>
+class SpscQueue
+{
+public:
+    // Constructor. Every slot starts as a copy of the prototype. The capacity must be a power of 2.
+    SpscQueue(std::size_t capacity, T const& prototype) :
+            c_mask(capacity - 1),
+            m_slots(capacity, prototype),
+            m_head(0),
+            m_tail(0),
+            m_cached_tail(0),
+            m_cached_head(0)
+    {
+        if (!IsPow2(capacity))
+            throw std::invalid_argument("Queue capacity must be a power of 2.");
+    }
+
+    // Producer: slot to fill next, nullptr while the queue is full.
+    T* TryBeginPush()
+    {
+        std::uint64_t const head = m_head.load(std::memory_order_relaxed);
+
+        // Reload the consumer index only when the cached one says the queue is full.
+        if (head - m_cached_tail > c_mask)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cached_tail > c_mask)
+                return nullptr;
+        }
+
+        return &m_slots[head & c_mask];
+    }
+
+    // Producer: publish the slot returned by TryBeginPush.
+    void Push() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Consumer: oldest published slot, nullptr while the queue is empty.
+    T* TryFront()
+    {
+        std::uint64_t const tail = m_tail.load(std::memory_order_relaxed);
+
+        // Reload the producer index only when the cached one says the queue is empty.
+        if (tail == m_cached_head)
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail == m_cached_head)
+                return nullptr;
+        }
+
+        return &m_slots[tail & c_mask];
+    }
+
+    // Consumer: release the slot returned by TryFront.
+    void Pop() { m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+private:
+    // Cache line size used to keep the producer and consumer indices apart.
+    static constexpr std::size_t c_cache_line = 64;
+
+    // Capacity - 1.
+    std::uint64_t const c_mask;
+
+    // Slots.
+    std::vector<T> m_slots;
+
+    // Slots published by the producer.
+    alignas(c_cache_line) std::atomic<std::uint64_t> m_head;
+
+    // Slots released by the consumer.
+    alignas(c_cache_line) std::atomic<std::uint64_t> m_tail;
+
+    // Producer copy of the consumer index.
+    alignas(c_cache_line) std::uint64_t m_cached_tail;
+
+    // Consumer copy of the producer index.
+    alignas(c_cache_line) std::uint64_t m_cached_head;
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,102 @@
+/**
+ * @file      sweep_runner.h
+ * @brief     Sweep runner class definition. Runs a parameter grid as jobs claimed from a shared directory.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include <utils/batch_runner.h>
+#include <utils/config_reader.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// One point of a sweep: an input trace and the swept cache parameters. The rest comes from the sweep configuration.
+struct SweepJob
+{
+    // Index in the manifest.
+    std::size_t m_id = 0;
+
+    // Input trace, as an absolute path.
+    std::string m_input_file;
+
+    // Cache geometry.
+    std::size_t m_sets = 0;
+    std::size_t m_ways = 0;
+    std::size_t m_line_size = 0;
+
+    // Store policies.
+    WritePolicy m_write_policy = WritePolicy::WRITE_BACK;
+    bool m_write_allocate = true;
+};
+
+// Progress of a sweep, as seen by a merge.
+struct SweepSummary
+{
+    // Jobs by state: with a result (stored, reused or failed), claimed without a result, and unclaimed.
+    std::size_t m_done = 0;
+    std::size_t m_failed = 0;
+    std::size_t m_running = 0;
+    std::size_t m_pending = 0;
+};
+
+// A sweep lives in a directory shared by every worker, which stands in for a job scheduler:
+//
+//     <directory>/sweep.conf     Configuration every job starts from.
+//     <directory>/manifest.tsv   One job per line: id, input trace and swept parameters.
+//     <directory>/claims/<id>    Created with O_EXCL by the worker that runs the job (host and pid inside).
+//     <directory>/results/<id>   Statistics of the job, renamed into place once complete.
+//     <directory>/outputs/<id>.trace
+//
+// Any amount of worker processes, on any host that mounts the directory, claim the jobs in manifest order. An
+// exclusive create succeeds for exactly one of them, so every job runs once. A merge can run at any time.
+class SweepRunner
+{
+public:
+    // Expand the [SWEEP] grid of a configuration file into a new sweep directory. Returns the amount of jobs.
+    static std::size_t Plan(std::string const& config_file, std::string const& directory);
+
+    // Constructor. A worker process of a planned sweep, running jobs on the given amount of threads.
+    SweepRunner(std::string const& directory, unsigned threads, bool pin_threads, std::string const& result_store = "");
+
+    // Claim and run jobs until every job is claimed. Returns the amount of jobs run by this process.
+    std::size_t Work();
+
+    // Gather the results into a CSV table, one row per job of the manifest, and print a summary.
+    static SweepSummary Merge(std::string const& directory, std::string const& report_file, std::ostream& stream);
+private:
+    // Sweep directory.
+    std::filesystem::path const c_directory;
+
+    // Amount of worker threads.
+    unsigned const c_thread_count;
+
+    // Bind each worker to a CPU.
+    bool const c_pin_threads;
+
+    // Result store directory. Empty disables the store.
+    std::string const c_result_store;
+
+
+    // Read the jobs of a manifest.
+    static std::vector<SweepJob> ReadManifest(std::filesystem::path const& directory);
+
+    // Claim a job for this process. False if another worker holds it.
+    bool Claim(SweepJob const& job) const;
+
+    // Publish the result of a job.
+    void WriteResult(SweepJob const& job, BatchResult const& result) const;
+};
+
+#endif // SWEEP_RUNNER_H
@@ -0,0 +1,63 @@
+/**
+ * @file      thread_pool.h
+ * @brief     Work-stealing thread pool class definition. Runs a set of independent tasks.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    // A task. Receives the index of the worker running it.
+    using Task = std::function<void(unsigned worker)>;
+
+    // Constructor. 0 threads uses one worker per allowed CPU. Pinned workers are bound to one CPU each.
+    ThreadPool(unsigned threads, bool pin_threads);
+
+    // Run the tasks and wait for all of them. Tasks are dealt round-robin in the given order, so list
+    // the longest first. Each worker runs its own tasks front to back; an idle worker steals from the
+    // back of the others. The first exception thrown by a task is rethrown once every task is done.
+    void Run(std::vector<Task> tasks);
+
+    // Amount of workers.
+    unsigned GetThreadCount() const { return c_thread_count; }
+private:
+    // Tasks assigned to a worker.
+    struct WorkerQueue
+    {
+        // Protects the tasks. Only contended when stealing.
+        std::mutex m_mutex;
+
+        // Pending tasks.
+        std::deque<Task> m_tasks;
+    };
+
+    // Amount of workers.
+    unsigned const c_thread_count;
+
+    // Bind each worker to a CPU.
+    bool const c_pin_threads;
+
+    // One queue per worker.
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+
+    // Fetch the next task of a worker, stealing if its queue is empty. Returns false when no task is left.
+    bool NextTask(unsigned worker, Task& task);
+};
+
+#endif // THREAD_POOL_H
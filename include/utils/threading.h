@@ -0,0 +1,30 @@
+/**
+ * @file      threading.h
+ * @brief     Thread placement helpers.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef THREADING_H
+#define THREADING_H
+
+#include <vector>
+
+// CPUs the process is allowed to run on, in increasing order.
+std::vector<unsigned> GetAllowedCpus();
+
+// Bind the calling thread to a CPU. Returns false if the platform refuses.
+bool PinCurrentThread(unsigned cpu);
+
+// Allow the calling thread to run on a set of CPUs, e.g. to undo a PinCurrentThread. Returns false if the platform refuses.
+bool SetCurrentThreadCpus(std::vector<unsigned> const& cpus);
+
+// Amount of worker threads for a request. 0 means one per allowed CPU.
+unsigned ResolveThreadCount(unsigned requested);
+
+#endif // THREADING_H
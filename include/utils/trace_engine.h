@@ -14,35 +14,49 @@
 #define TRACE_ENGINE_H
 
 #include <typedefs.h>
+#include <utils/memory_sink.h>
+#include <utils/trace_format.h>
+
+#include <fstream>
 #include <string>
 
-class TraceEngine
+class TraceEngine : public MemorySink
 {
 public:
-    // Opens the output file.
-    static void Initialize(std::string const& trace_file);
+    // Constructor. Opens the output file. A quiet engine does not announce overwritten files.
+    TraceEngine(std::string const& trace_file, bool quiet = false, TraceFormat format = TraceFormat::TEXT);
+
+    // Destructor. Closes the output file if still open.
+    ~TraceEngine();
 
     // Closes the output file.
-    static void Shutdown();
+    void Shutdown();
 
-    // Record a load in the trace.
-    static void Load(address_t const address);
+    // Record a request in the trace. All but text traces keep the cycle; FLUSH requests are recorded as flush points,
+    // except in the DRAM simulator formats.
+    void Send(MemoryRequest const& request) override;
 
-    // Record a store in the trace.
-    static void Store(address_t const address);
+    // Requests recorded so far of an operation type.
+    std::uint64_t GetRequestCount(Operation operation) const { return m_request_counts[operation]; }
 private:
     // Output file stream.
-    static std::ofstream m_output_file;
+    std::ofstream m_output_file;
+
+    // Format of the output.
+    TraceFormat const c_format;
 
     // Is active.
-    static bool m_is_active;
+    bool m_is_active;
 
     // Has it been shutdown.
-    static bool m_is_shutdown;
+    bool m_is_shutdown;
+
+    // Requests recorded, per operation type.
+    std::uint64_t m_request_counts[3];
 
 
     // Is the TraceEngine Active? (Initialized and not shutdown)
-    static void CheckActive();
+    void CheckActive() const;
 };
 
-#endif // TRACE_ENGINE_H
\ No newline at end of file
+#endif // TRACE_ENGINE_H
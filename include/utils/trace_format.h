@@ -0,0 +1,141 @@
+/**
+ * @file      trace_format.h
+ * @brief     Trace file formats: text, text with a timestamp column, and fixed-size binary records.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+// Text:    one access per line, "LD 0x7f0000001000" or "ST 0x7f0000001040". "FLUSH" lines are flush points,
+//          "ROI_BEGIN" and "ROI_END" lines delimit the region of interest.
+// Timed:   text with a decimal timestamp column, "LD 0x7f0000001000 1234" or "FLUSH 1234".
+// Binary:  a Header followed by 16-byte Records, little-endian. Readers detect it by the magic. Markers are
+//          records with the flush flag and a non-zero address field (c_roi_begin_word, c_roi_end_word).
+//
+// Output only, for cycle-level DRAM simulators. Flush points are left out.
+// DRAMSim3: "0x7f0000001000 READ 1234" or "0x7f0000001040 WRITE 1234".
+// DRAMSys:  "1234:\tread\t0x7f0000001000" or "1234:\twrite\t0x7f0000001040" (.stl trace player).
+
+#include <typedefs.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// Trace file formats.
+enum class TraceFormat
+{
+    TEXT,
+    TIMED,
+    BINARY,
+    DRAMSIM3,
+    DRAMSYS
+};
+
+namespace trace_format
+{
+    // File signature ("TBTRACE1").
+    constexpr std::uint64_t c_magic = 0x3145434152544254ull;
+
+    // Layout version.
+    constexpr std::uint32_t c_version = 1;
+
+    // Bit of a record word that flags a store.
+    constexpr std::uint64_t c_store_bit = 1ull << 63;
+
+    // Bit of a record word that flags a flush point.
+    constexpr std::uint64_t c_flush_bit = 1ull << 62;
+
+    // Bits of a record word that hold the address.
+    constexpr std::uint64_t c_address_mask = c_flush_bit - 1;
+
+    // Record words of the region-of-interest markers.
+    constexpr std::uint64_t c_roi_begin_word = c_flush_bit | 1;
+    constexpr std::uint64_t c_roi_end_word = c_flush_bit | 2;
+
+    // File header. Placed at offset 0.
+    struct Header
+    {
+        // File signature.
+        std::uint64_t m_magic;
+
+        // Layout version.
+        std::uint32_t m_version;
+
+        // Bytes per record.
+        std::uint32_t m_record_size;
+    };
+
+    // An access.
+    struct Record
+    {
+        // Address and operation flags.
+        std::uint64_t m_word;
+
+        // Timestamp (issue cycle), or the position in the trace when the source had none.
+        std::uint64_t m_timestamp;
+    };
+
+    static_assert(sizeof(Header) == 16 && sizeof(Record) == 16, "Binary traces use 16-byte headers and records.");
+
+    // Encode the word of a record.
+    inline std::uint64_t Encode(Operation operation, address_t address)
+    {
+        if (operation == FLUSH)
+            return c_flush_bit;
+
+        return (address & c_address_mask) | (operation == STORE ? c_store_bit : 0);
+    }
+
+    // Decode the word of a record.
+    inline void Decode(std::uint64_t word, Operation& operation, address_t& address)
+    {
+        operation = (word & c_flush_bit) ? FLUSH : (word & c_store_bit) ? STORE : LOAD;
+        address = word & c_address_mask;
+    }
+
+    // Whether a record word is a marker rather than an access or a flush point.
+    inline bool IsMarker(std::uint64_t word)
+    {
+        return (word & c_flush_bit) && (word & c_address_mask) != 0;
+    }
+
+    // Parse a format name ("text", "timed", "binary", "dramsim3" or "dramsys").
+    inline TraceFormat Parse(std::string const& name)
+    {
+        if (name == "text")
+            return TraceFormat::TEXT;
+        if (name == "timed")
+            return TraceFormat::TIMED;
+        if (name == "binary")
+            return TraceFormat::BINARY;
+        if (name == "dramsim3")
+            return TraceFormat::DRAMSIM3;
+        if (name == "dramsys")
+            return TraceFormat::DRAMSYS;
+
+        throw std::invalid_argument("Unknown trace format '" + name + "'. Expected text, timed, binary, dramsim3 or dramsys.");
+    }
+
+    // Name of a format.
+    inline char const* Name(TraceFormat format)
+    {
+        switch (format)
+        {
+            case TraceFormat::TIMED:    return "timed";
+            case TraceFormat::BINARY:   return "binary";
+            case TraceFormat::DRAMSIM3: return "dramsim3";
+            case TraceFormat::DRAMSYS:  return "dramsys";
+            default:                    return "text";
+        }
+    }
+}
+
+#endif // TRACE_FORMAT_H
@@ -0,0 +1,138 @@
+/**
+ * @file      trace_generator.h
+ * @brief     Synthetic trace generator class definition. Produces reproducible input traces.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef TRACE_GENERATOR_H
+#define TRACE_GENERATOR_H
+
+#include <typedefs.h>
+
+#include <string>
+#include <vector>
+
+// Access patterns supported by the generator.
+enum class AccessPattern
+{
+    STREAMING,
+    STRIDED,
+    RANDOM,
+    ZIPFIAN,
+    POINTER_CHASE
+};
+
+// A phase of a (possibly mixed) workload. Phases are replayed cyclically.
+struct GeneratorPhase
+{
+    // Pattern of the phase.
+    AccessPattern m_pattern;
+
+    // Accesses per occurrence of the phase.
+    std::uint64_t m_length;
+};
+
+struct GeneratorConfig
+{
+    // Workload phases. A single phase produces a pure pattern.
+    std::vector<GeneratorPhase> m_phases;
+
+    // Total amount of accesses.
+    std::uint64_t m_accesses = 1000000;
+
+    // Bytes touched by the workload.
+    std::uint64_t m_footprint = 64 << 20;
+
+    // First address of the footprint.
+    address_t m_base_address = 0x7f0000000000;
+
+    // Cache line size used by the line-granular patterns.
+    std::uint64_t m_line_size = 64;
+
+    // Size of each access for the streaming pattern.
+    std::uint64_t m_element_size = 8;
+
+    // Distance between consecutive accesses of the strided pattern.
+    std::uint64_t m_stride = 256;
+
+    // Fraction of stores.
+    double m_write_ratio = 0.3;
+
+    // Skew of the Zipfian distribution. Must be in (0, 1).
+    double m_zipf_theta = 0.99;
+
+    // Seed of all random decisions.
+    std::uint64_t m_seed = 1;
+
+    // Worker threads used to write the trace. 0 uses all hardware threads.
+    unsigned m_threads = 0;
+
+    // Hexadecimal digits per address. Records have a fixed width so they can be written in parallel.
+    unsigned m_address_digits = 12;
+};
+
+class TraceGenerator
+{
+public:
+    // Constructor. Validates the configuration and precomputes the pattern state.
+    TraceGenerator(GeneratorConfig const& config);
+
+    // Access at a given position of the trace. Depends only on the configuration and the index.
+    void GetAccess(std::uint64_t index, Operation& op_type, address_t& address) const;
+
+    // Write the whole trace. Returns the amount of bytes written.
+    std::uint64_t Write(std::string const& filename) const;
+
+    // Bytes per trace record.
+    std::size_t GetRecordSize() const;
+
+    // Parse a pattern name ("streaming", "strided", "random", "zipfian", "pointer_chase").
+    static AccessPattern ParsePattern(std::string const& name);
+
+    // Name of a pattern.
+    static char const* PatternName(AccessPattern pattern);
+private:
+    // Generator configuration.
+    GeneratorConfig const c_config;
+
+    // Lines in the footprint.
+    std::uint64_t const c_footprint_lines;
+
+    // Accesses in a full cycle over all phases.
+    std::uint64_t const c_cycle_length;
+
+    // Store probability as a 64-bit threshold.
+    std::uint64_t const c_write_threshold;
+
+    // Phase start offsets within a cycle.
+    std::vector<std::uint64_t> m_phase_starts;
+
+    // Zipfian distribution constants.
+    double m_zipf_zetan;
+    double m_zipf_alpha;
+    double m_zipf_eta;
+
+    // Multiplier coprime with the footprint that scatters Zipfian ranks over the footprint.
+    std::uint64_t m_zipf_scatter;
+
+    // Visiting order of the pointer-chase cycle.
+    std::vector<std::uint32_t> m_chase_order;
+
+
+    // Address of the index-th access of a pattern.
+    address_t PatternAddress(AccessPattern pattern, std::uint64_t index) const;
+
+    // Zipfian rank for a uniform random value.
+    std::uint64_t ZipfRank(std::uint64_t random) const;
+
+    // Format the records [begin, end) into a buffer.
+    void Format(std::uint64_t begin, std::uint64_t end, char* buffer) const;
+};
+
+#endif // TRACE_GENERATOR_H
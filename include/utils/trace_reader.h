@@ -14,7 +14,23 @@
 #define TRACE_READER_H
 
 #include <typedefs.h>
+#include <utils/trace_format.h>
+
 #include <string>
+#include <vector>
+
+// Byte offsets of the part of a trace that is simulated: functional warmup, then measurement.
+struct TraceRegion
+{
+    // Start of the warmup. Everything before it is fast-forwarded.
+    std::size_t m_warmup_begin;
+
+    // Start of the measurement, end of the warmup.
+    std::size_t m_measure_begin;
+
+    // End of the measurement.
+    std::size_t m_measure_end;
+};
 
 class TraceReader
 {
@@ -25,8 +41,58 @@ public:
     // Destructor. Unmaps the file and closes the file descriptor.
     ~TraceReader();
 
-    // Retrieves the next memory access from the trace.
+    // Retrieves the next memory access from the trace. FLUSH marker lines are returned as FLUSH operations;
+    // ROI markers are skipped. The address filter does not apply.
     bool GetNextAccess(Operation& op_type, address_t& address);
+
+    // Retrieves the next memory access and its timestamp. The timestamp is TIMESTAMP_MAX when the trace has none.
+    bool GetNextTimedAccess(Operation& op_type, address_t& address, timestamp_t& timestamp);
+
+    // Retrieves up to max_count accesses that pass the address filter. Returns the amount read, 0 at the end of the trace.
+    std::size_t GetNextAccesses(MemoryAccess* accesses, std::size_t max_count);
+
+    // Keep only the accesses inside an include range, if any, and outside every exclude range. Flush points are kept.
+    void SetFilter(std::vector<AddressRange> const& include, std::vector<AddressRange> const& exclude);
+
+    // Accesses dropped by the address filter so far.
+    std::uint64_t GetFilteredCount() const { return m_filtered_count; }
+
+    // Locate the simulated part of the trace. The measurement starts skip accesses into the trace, or into the
+    // region of interest (after the first ROI_BEGIN marker), and is preceded by up to warmup accesses. It lasts
+    // measure accesses (0 for all), and never goes past the ROI_END marker that closes the region of interest.
+    // Lines are counted without parsing them, flush points and markers included.
+    TraceRegion FindRegion(bool roi, std::uint64_t skip, std::uint64_t warmup, std::uint64_t measure) const;
+
+    // Restrict reading to the bytes [begin, end). Both must be line starts (or the file size).
+    // In binary traces, lines are records.
+    void SetRange(std::size_t begin, std::size_t end);
+
+    // Offsets that cut the trace into slices of about the same size, aligned to line starts. Returns slices + 1 offsets.
+    std::vector<std::size_t> GetSliceOffsets(std::size_t slices) const;
+
+    // Same, for the lines in [begin, end).
+    std::vector<std::size_t> GetSliceOffsets(std::size_t slices, std::size_t begin, std::size_t end) const;
+
+    // Start of the line that is the given amount of lines before a line start. Stops at the beginning of the trace.
+    std::size_t RewindLines(std::size_t offset, std::size_t lines) const;
+
+    // Start of the line that is the given amount of lines after a line start. Stops at the end of the trace.
+    std::size_t AdvanceLines(std::size_t offset, std::size_t lines) const;
+
+    // Amount of lines in [begin, end).
+    std::size_t CountLines(std::size_t begin, std::size_t end) const;
+
+    // Size of the trace in bytes.
+    std::size_t GetFileSize() const { return m_file_size; }
+
+    // Offset of the first line (past the header of binary traces).
+    std::size_t GetDataBegin() const { return m_data_begin; }
+
+    // Raw bytes of the trace.
+    char const* GetData() const { return m_data; }
+
+    // Format of the trace. Text traces report TEXT whether or not they have a timestamp column.
+    TraceFormat GetFormat() const { return m_binary ? TraceFormat::BINARY : TraceFormat::TEXT; }
 private:
     // Hexadecimal lookup table.
     static uint8_t c_hex_lookup[256];
@@ -34,6 +100,24 @@ private:
     // Current cursor position in the mapped data.
     std::size_t m_cursor;
 
+    // End of the readable range.
+    std::size_t m_end;
+
+    // Binary trace of fixed-size records.
+    bool m_binary;
+
+    // Offset of the first line.
+    std::size_t m_data_begin;
+
+    // Timestamp column of the last text line read, TIMESTAMP_MAX if it had none.
+    timestamp_t m_timestamp;
+
+    // Address filter: enabled, ranges, and accesses dropped.
+    bool m_filtering;
+    std::vector<AddressRange> m_include_ranges;
+    std::vector<AddressRange> m_exclude_ranges;
+    std::uint64_t m_filtered_count;
+
     // File descriptor.
     int m_fd;
 
@@ -42,6 +126,31 @@ private:
 
     // File size.
     std::size_t m_file_size;
+
+
+    // Whether an access passes the address filter. Counts the accesses it drops.
+    bool Keep(MemoryAccess const& access)
+    {
+        if (!m_filtering || access.m_operation == FLUSH)
+            return true;
+
+        bool keep = m_include_ranges.empty();
+
+        for (AddressRange const& range : m_include_ranges)
+            keep |= range.Contains(access.m_address);
+
+        for (AddressRange const& range : m_exclude_ranges)
+            keep &= !range.Contains(access.m_address);
+
+        m_filtered_count += !keep;
+        return keep;
+    }
+
+    // Offset of the first line at or after an offset that is a marker, the end of the trace if there is none.
+    std::size_t FindMarker(std::size_t offset, bool begin) const;
+
+    // Skip the rest of a ROI marker line, past its first two characters.
+    void SkipMarker();
 };
 
 #endif // TRACE_READER_H
\ No newline at end of file
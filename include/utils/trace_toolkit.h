@@ -0,0 +1,97 @@
+/**
+ * @file      trace_toolkit.h
+ * @brief     Trace toolkit class definition. Splits, merges, converts and summarizes traces in parallel.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef TRACE_TOOLKIT_H
+#define TRACE_TOOLKIT_H
+
+#include <typedefs.h>
+#include <utils/trace_format.h>
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// How merged traces are interleaved.
+enum class MergeOrder
+{
+    // By timestamp. Ties keep the order of the inputs.
+    TIMESTAMP,
+
+    // A fixed amount of accesses from each input in turn.
+    ROUND_ROBIN
+};
+
+// Summary of a trace.
+struct TraceStats
+{
+    // Stride buckets: bucket 0 is the same line, bucket k > 0 holds strides of [2^(k-1), 2^k) lines.
+    static constexpr std::size_t c_stride_buckets = 65;
+
+    // Operations.
+    std::uint64_t m_loads = 0;
+    std::uint64_t m_stores = 0;
+    std::uint64_t m_flushes = 0;
+
+    // Distinct lines and pages touched.
+    std::uint64_t m_footprint_lines = 0;
+    std::uint64_t m_footprint_pages = 0;
+
+    // Lowest and highest address.
+    address_t m_min_address = ~address_t(0);
+    address_t m_max_address = 0;
+
+    // Histogram of the distance between consecutive accesses, in lines, by magnitude and direction.
+    std::array<std::uint64_t, c_stride_buckets> m_forward_strides = {};
+    std::array<std::uint64_t, c_stride_buckets> m_backward_strides = {};
+};
+
+class TraceToolkit
+{
+public:
+    // Constructor. 0 threads uses one worker per allowed CPU.
+    explicit TraceToolkit(unsigned threads);
+
+    // Format of a trace: binary by its header, timed if its first line has a timestamp column, text otherwise.
+    static TraceFormat DetectFormat(std::string const& input);
+
+    // Cut a trace into parts of a fixed amount of accesses, or of about a fixed amount of bytes cut at line
+    // starts (exactly one of them non-zero). Parts are named <prefix>_<index>.trace. Returns the parts.
+    std::vector<std::string> Split(std::string const& input, std::string const& prefix, std::uint64_t accesses, std::uint64_t bytes, TraceFormat format) const;
+
+    // Interleave traces into one. Returns the amount of accesses written.
+    std::uint64_t Merge(std::vector<std::string> const& inputs, std::string const& output, MergeOrder order, std::uint64_t quantum, TraceFormat format) const;
+
+    // Rewrite a trace in another format. Returns the amount of accesses written.
+    std::uint64_t Convert(std::string const& input, std::string const& output, TraceFormat format) const;
+
+    // Copy the first accesses of a trace. An empty output prints them as text. Returns the amount of accesses written.
+    std::uint64_t Head(std::string const& input, std::string const& output, std::uint64_t accesses, TraceFormat format) const;
+
+    // Summarize a trace.
+    TraceStats Stats(std::string const& input, std::uint64_t line_size, std::uint64_t page_size) const;
+
+    // Print a summary.
+    static void PrintStats(std::ostream& stream, TraceStats const& stats, std::uint64_t line_size, std::uint64_t page_size);
+private:
+    // Amount of worker threads.
+    unsigned const c_thread_count;
+
+
+    // Write the lines [begin, end) of an input in a format. Traces without timestamps are stamped with the position
+    // of each access in the input, starting at first_index. Returns the amount of accesses written.
+    std::uint64_t WriteRange(std::string const& input, TraceFormat input_format, std::size_t begin, std::size_t end,
+                             std::uint64_t first_index, std::string const& output, TraceFormat format) const;
+};
+
+#endif // TRACE_TOOLKIT_H
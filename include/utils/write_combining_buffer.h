@@ -0,0 +1,72 @@
+/**
+ * @file      write_combining_buffer.h
+ * @brief     Write-combining buffer class definition. Coalesces the requests to the same line before memory.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#ifndef WRITE_COMBINING_BUFFER_H
+#define WRITE_COMBINING_BUFFER_H
+
+#include <utils/memory_sink.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Holds the last requests on their way to a target, oldest first, and forwards the oldest one when a new
+// request needs room. A request to a line that is already buffered is combined with the newest request to
+// that line: a store after a store is merged, a fill after a store is served from the buffered data, and a
+// fill after a fill is redundant. A store after a fill is kept, after it. Requests leave in arrival order,
+// with their original cycle. Flush points drain the buffer first.
+class WriteCombiningBuffer final : public MemorySink
+{
+public:
+    // Constructor. Requests are forwarded to the target.
+    WriteCombiningBuffer(std::size_t entries, MemorySink& target);
+
+    // Combine or buffer a request.
+    void Send(MemoryRequest const& request) override;
+
+    // Forward every buffered request, oldest first. Must be called at the end of a run.
+    void Drain();
+
+    // Print the amount of requests received, combined and forwarded.
+    void PrintStatistics(std::ostream& stream) const;
+private:
+    // Destination of the requests.
+    MemorySink& m_target;
+
+    // Requests the buffer holds.
+    std::size_t const c_capacity;
+
+
+    // Buffered requests, a ring starting at m_oldest.
+    std::vector<MemoryRequest> m_entries;
+    std::size_t m_oldest;
+    std::size_t m_count;
+
+    // Requests received, by operation.
+    std::uint64_t m_received[2];
+
+    // Stores merged into a buffered store.
+    std::uint64_t m_merged_stores;
+
+    // Fills served by a buffered store, and fills merged into a buffered fill.
+    std::uint64_t m_forwarded_loads;
+    std::uint64_t m_merged_loads;
+
+    // Requests forwarded to the target, flush points excluded.
+    std::uint64_t m_forwarded;
+
+
+    // Forward the oldest buffered request.
+    void Evict();
+};
+
+#endif // WRITE_COMBINING_BUFFER_H
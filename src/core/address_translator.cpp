@@ -0,0 +1,232 @@
+/**
+ * @file      address_translator.cpp
+ * @brief     Address translator class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <core/address_translator.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    // Page-table geometry: 4 KiB tables of 512 8-byte entries, indexed by 9 address bits per level.
+    constexpr unsigned c_table_shift = 12;
+    constexpr unsigned c_level_bits = 9;
+    constexpr std::uint64_t c_entry_size = 8;
+
+    // Slots of an empty page table.
+    constexpr std::size_t c_initial_slots = 1 << 12;
+
+    // Smallest amount of bits that holds values up to n - 1. At least one.
+    unsigned BitsFor(std::uint64_t n)
+    {
+        unsigned bits = 1;
+        while (bits < 64 && (std::uint64_t(1) << bits) < n)
+            ++bits;
+
+        return bits;
+    }
+
+    // SplitMix64 finalizer.
+    std::uint64_t Mix(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+}
+
+PageTable::PageTable(unsigned frame_bits) :
+        c_frame_bits(frame_bits),
+        c_max_page((std::uint64_t(1) << (64 - frame_bits)) - 1),
+        m_slots(c_initial_slots, 0),
+        m_mask(c_initial_slots - 1),
+        m_size(0)
+{
+}
+
+void PageTable::Grow()
+{
+    std::vector<std::uint64_t> slots(m_slots.size() * 2, 0);
+    m_mask = slots.size() - 1;
+
+    for (std::uint64_t const entry : m_slots)
+    {
+        if (entry == 0)
+            continue;
+
+        std::size_t slot = Slot((entry >> c_frame_bits) - 1);
+        while (slots[slot] != 0)
+            slot = (slot + 1) & m_mask;
+
+        slots[slot] = entry;
+    }
+
+    m_slots.swap(slots);
+}
+
+AddressTranslator::AddressTranslator(Config const& config) :
+        c_page_size(config.m_page_size),
+        c_page_shift(static_cast<unsigned>(__builtin_ctzll(config.m_page_size))),
+        c_page_mask(config.m_page_size - 1),
+        c_allocation(config.m_page_allocation),
+        c_frame_count(config.m_physical_memory / config.m_page_size),
+        c_node_count(config.m_page_allocation == PageAllocation::NUMA ? config.m_numa_nodes : 1),
+        c_node_frames(c_frame_count / c_node_count),
+        c_permutation_bits(BitsFor(c_frame_count)),
+        c_permutation_keys{Mix(config.m_translation_seed), Mix(config.m_translation_seed + 1)},
+        c_tlb_mask(config.m_tlb_entries - 1),
+        c_page_walks(config.m_page_walks),
+        c_walk_levels(config.m_page_size == (std::size_t(2) << 20) ? 3 : 4),
+        m_pages(BitsFor(c_frame_count)),
+        m_tables(BitsFor(c_frame_count)),
+        m_root_frame(0),
+        m_allocated(0),
+        m_node_allocated(c_node_count, 0),
+        m_tlb_pages(config.m_tlb_entries, ~std::uint64_t(0)),
+        m_tlb_frames(config.m_tlb_entries, 0)
+{
+    if (!IsPow2(c_page_size) || c_page_size < (std::size_t(1) << c_table_shift))
+        throw std::invalid_argument("Address translation: page size must be a power of 2 of at least 4 KiB.");
+
+    if (c_frame_count == 0 || c_node_frames == 0)
+        throw std::invalid_argument("Address translation: physical memory must hold at least one frame per node.");
+
+    if (!IsPow2(config.m_tlb_entries))
+        throw std::invalid_argument("Address translation: TLB entries must be a power of 2.");
+
+    // The root table is allocated up front, like the one of a process.
+    if (c_page_walks)
+        m_root_frame = AllocateFrame(0);
+}
+
+void AddressTranslator::TranslateSlow(MemoryAccess const& access, std::vector<MemoryAccess>& output)
+{
+    if (access.m_operation == FLUSH)
+    {
+        output.push_back(access);
+        return;
+    }
+
+    std::uint64_t const page = access.m_address >> c_page_shift;
+
+    ++m_stats.m_accesses;
+    ++m_stats.m_tlb_misses;
+
+    if (c_page_walks)
+    {
+        // Load the entry of every level, from the root down. Tables live in the first 4 KiB of their frame.
+        std::uint64_t table = m_root_frame;
+
+        for (unsigned level = 4; level > 4 - c_walk_levels; --level)
+        {
+            unsigned const index_shift = c_table_shift + c_level_bits * (level - 1);
+            std::uint64_t const index = (access.m_address >> index_shift) & ((1 << c_level_bits) - 1);
+
+            output.push_back({LOAD, (table << c_page_shift) + index * c_entry_size});
+            ++m_stats.m_walk_loads;
+
+            // The next table down, identified by its level and the address bits above it.
+            if (level - 1 > 4 - c_walk_levels)
+            {
+                std::uint64_t const key = ((access.m_address >> index_shift) << 2) | (level - 1);
+                table = m_tables.FindOrInsert(key, [this](std::uint64_t key) { return AllocateFrame(key >> 2); });
+            }
+        }
+    }
+
+    std::uint64_t const faults = m_pages.GetSize();
+    std::uint64_t const frame = m_pages.FindOrInsert(page, [this](std::uint64_t page) { return AllocateFrame(page); });
+    m_stats.m_page_faults += m_pages.GetSize() - faults;
+
+    std::size_t const entry = static_cast<std::size_t>(page) & c_tlb_mask;
+    m_tlb_pages[entry] = page;
+    m_tlb_frames[entry] = frame;
+
+    output.push_back({access.m_operation, (frame << c_page_shift) | (access.m_address & c_page_mask), access.m_timestamp});
+}
+
+std::uint64_t AddressTranslator::AllocateFrame(std::uint64_t page)
+{
+    if (c_allocation == PageAllocation::NUMA)
+    {
+        // Interleave by page number, consecutive frames within the node.
+        std::uint64_t const node = page % c_node_count;
+
+        if (m_node_allocated[node] == c_node_frames)
+            throw std::runtime_error("Address translation: NUMA node " + std::to_string(node) + " is out of frames. Increase physical_memory_gb.");
+
+        ++m_allocated;
+        return node * c_node_frames + m_node_allocated[node]++;
+    }
+
+    if (m_allocated == c_frame_count)
+        throw std::runtime_error("Address translation: physical memory is out of frames. Increase physical_memory_gb.");
+
+    std::uint64_t const index = m_allocated++;
+    return c_allocation == PageAllocation::RANDOM ? Permute(index) : index;
+}
+
+std::uint64_t AddressTranslator::Permute(std::uint64_t index) const
+{
+    // Keyed rounds of bijections of [0, 2^bits): xor with a key, odd multiplication and xorshift. Values
+    // that land outside [0, frames) are permuted again (cycle walking), which keeps the result a bijection.
+    unsigned const bits = c_permutation_bits;
+    std::uint64_t const mask = bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+
+    do
+    {
+        for (std::uint64_t const key : c_permutation_keys)
+        {
+            index = (index ^ key) & mask;
+            index = (index * 0x9e3779b97f4a7c15ull) & mask;
+            index ^= index >> (bits / 2 + 1);
+        }
+    }
+    while (index >= c_frame_count);
+
+    return index;
+}
+
+void AddressTranslator::PrintConfiguration(std::ostream& stream) const
+{
+    static char const* const c_allocation_names[] = {"sequential", "random", "numa"};
+
+    stream << "Translation:    " << std::endl;
+    stream << "    Page size:  " << c_page_size << " bytes" << std::endl;
+    stream << "    Frames:     " << c_frame_count << " (" << (c_frame_count * c_page_size >> 20) << " MiB)" << std::endl;
+    stream << "    Allocation: " << c_allocation_names[static_cast<int>(c_allocation)];
+    if (c_allocation == PageAllocation::NUMA)
+        stream << ", " << c_node_count << " nodes of " << c_node_frames << " frames";
+    stream << std::endl;
+    stream << "    TLB:        " << c_tlb_mask + 1 << " entries, direct-mapped" << std::endl;
+    stream << "    Page walks: " << (c_page_walks ? std::to_string(c_walk_levels) + " levels" : "off") << std::endl;
+    stream << std::endl;
+}
+
+void AddressTranslator::PrintStatistics(std::ostream& stream) const
+{
+    std::ios::fmtflags const flags = stream.flags();
+
+    stream << "Translation Statistics:" << std::endl;
+    stream << "    Accesses:        " << m_stats.m_accesses << std::endl;
+    stream << std::fixed << std::setprecision(2);
+    stream << "    TLB misses:      " << m_stats.m_tlb_misses << " ("
+           << (m_stats.m_accesses ? 100.0 * m_stats.m_tlb_misses / m_stats.m_accesses : 0.0) << " %)" << std::endl;
+    stream << "    Pages touched:   " << m_stats.m_page_faults << " (" << static_cast<double>(m_stats.m_page_faults * c_page_size) / (1 << 20) << " MiB)" << std::endl;
+    if (c_page_walks)
+        stream << "    Walk loads:      " << m_stats.m_walk_loads << " (" << m_tables.GetSize() << " page-table pages)" << std::endl;
+    stream << "    Frames used:     " << m_allocated << " of " << c_frame_count << std::endl;
+    stream << "    Table memory:    " << static_cast<double>(m_pages.GetMemoryUsage() + m_tables.GetMemoryUsage()) / (1 << 20) << " MiB" << std::endl;
+
+    stream.flags(flags);
+}
@@ -12,14 +12,28 @@
 
 #include <core/cache.h>
 
-#include <utils/clock.h>
-
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <new>
 #include <stdexcept>
 
-Cache::Cache(std::size_t sets, std::size_t ways, std::size_t line_size) :
+namespace
+{
+    // Bytes of the CacheSet header of an arena slot. Its storage follows, aligned to 8.
+    constexpr std::size_t c_set_header = (sizeof(CacheSet) + 7) & ~std::size_t(7);
+
+    // Bytes of an arena slot, rounded up to a host cache line so that no two sets share one.
+    std::size_t GetSetStride(std::size_t ways)
+    {
+        return (c_set_header + CacheSet::GetStorageSize(static_cast<way_t>(ways)) + 63) & ~std::size_t(63);
+    }
+}
+
+Cache::Cache(std::size_t sets, std::size_t ways, std::size_t line_size, MemorySink& sink, std::size_t prefetch_distance,
+             std::uint64_t flush_interval, FlushMode flush_mode, WritePolicy write_policy, bool write_allocate, bool streaming_stores,
+             bool huge_pages) :
         c_set_count(sets),
         c_way_count(ways),
         c_line_size(line_size),
@@ -27,19 +41,21 @@ Cache::Cache(std::size_t sets, std::size_t ways, std::size_t line_size) :
         c_tag_shift(static_cast<address_t>(log2(c_set_count)) + c_set_shift),
         c_byte_mask((1 << static_cast<address_t>(log2(c_line_size))) - 1),
         c_set_mask((1 << static_cast<address_t>(log2(c_set_count))) - 1),
-        m_sets(sets)
-{
-    std::cout << "Cache:          " << std::endl;
-    std::cout << "    Sets:       " << c_set_count << std::endl;
-    std::cout << "    Ways:       " << c_way_count << std::endl;
-    std::cout << "    Line size:  " << line_size << " bytes" << std::endl;
-    std::cout << "    Cache size: " << c_set_count * c_way_count * line_size << " bytes" << std::endl;
-    std::cout << std::endl;
-    std::cout << "    Tag shift:  " << c_tag_shift << std::endl;
-    std::cout << "    Set shift:  " << c_set_shift << std::endl;
-    std::cout << "    Byte mask:  " << std::hex << std::setfill('0') << std::setw(16) << c_byte_mask << std::dec << std::endl;
-    std::cout << "    Set mask:   " << std::hex << std::setfill('0') << std::setw(16) << c_set_mask << std::dec << std::endl;
-
+        c_prefetch_distance(prefetch_distance),
+        c_flush_interval(flush_interval),
+        c_flush_mode(flush_mode),
+        c_write_through(write_policy == WritePolicy::WRITE_THROUGH),
+        c_write_allocate(write_allocate),
+        c_streaming_stores(streaming_stores),
+        c_set_stride(GetSetStride(ways)),
+        m_set_base(nullptr),
+        m_initialized_sets((sets + 63) / 64, 0),
+        m_sink(sink),
+        m_epoch_remaining(flush_interval),
+        m_occupied_sets((sets + 63) / 64, 0),
+        m_dirty_sets((sets + 63) / 64, 0),
+        m_l0_next(0)
+{
     // Validate parameters.
     if (!IsPow2(line_size))
         throw std::invalid_argument("Cache line size must be a power of 2.");
@@ -50,31 +66,232 @@ Cache::Cache(std::size_t sets, std::size_t ways, std::size_t line_size) :
     if (!IsPow2(c_way_count))
         throw std::invalid_argument("Cache ways amount must be a power of 2.");
 
-    // Initialize cache sets.
-    for (set_t i = 0; i < c_set_count; ++i)
-        m_sets[i] = new CacheSet(c_way_count, static_cast<set_t>(i));
+    if (c_prefetch_distance > MAX_PREFETCH_DISTANCE)
+        throw std::invalid_argument("Cache prefetch distance must be at most " + std::to_string(MAX_PREFETCH_DISTANCE) + ".");
+
+    // Reserve the sets. Nothing is touched until an access reaches a set.
+    m_arena = std::make_unique<MappedArena>(c_set_count * c_set_stride, huge_pages);
+    m_set_base = m_arena->GetBase();
+
+    // Initialize the L0. Invalid entries never match, so their set is never dereferenced.
+    m_l0.fill({0, nullptr, 0, false});
+}
+
+Cache::Cache(Config const& config, MemorySink& sink) :
+        Cache(config.m_sets, config.m_ways, config.m_line_size, sink, config.m_prefetch_distance, config.m_flush_interval, config.m_flush_mode,
+              config.m_write_policy, config.m_write_allocate, config.m_streaming_stores, config.m_huge_pages)
+{
+}
+
+void Cache::PrintConfiguration(std::ostream& stream) const
+{
+    std::ios::fmtflags const flags = stream.flags();
+    char const fill = stream.fill();
+
+    stream << "Cache:          " << std::endl;
+    stream << "    Sets:       " << c_set_count << std::endl;
+    stream << "    Ways:       " << c_way_count << std::endl;
+    stream << "    Line size:  " << c_line_size << " bytes" << std::endl;
+    stream << "    Cache size: " << c_set_count * c_way_count * c_line_size << " bytes" << std::endl;
+    stream << "    Writes:     " << (c_streaming_stores ? "streaming" : std::string(c_write_through ? "write-through" : "write-back") +
+                                    (c_write_allocate ? ", write-allocate" : ", no-write-allocate")) << std::endl;
+    stream << std::endl;
+    stream << "    Tag shift:  " << c_tag_shift << std::endl;
+    stream << "    Set shift:  " << c_set_shift << std::endl;
+    stream << "    Byte mask:  " << std::hex << std::setfill('0') << std::setw(16) << c_byte_mask << std::dec << std::endl;
+    stream << "    Set mask:   " << std::hex << std::setfill('0') << std::setw(16) << c_set_mask << std::dec << std::endl;
+
+    // Restore the stream state.
+    stream.flags(flags);
+    stream.fill(fill);
 }
 
 void Cache::PerformOperation(Operation const operation, address_t const address)
 {
+    if (operation != Operation::LOAD && operation != Operation::STORE)
+    {
+        if (operation != Operation::FLUSH)
+            throw std::invalid_argument("Unknown cache operation.");
+
+        FlushPoint();
+        return;
+    }
+
+    // Stores that do not simply dirty their line take the slow path.
+    if (operation == Operation::STORE && (c_write_through || !c_write_allocate || c_streaming_stores))
+    {
+        PerformStore(address);
+        Retire();
+        return;
+    }
+
+    // L0 fast path: a repeated hit on a recently accessed line skips the set lookup.
+    address_t const line_address = address & ~c_byte_mask;
+    for (L0Entry const& entry : m_l0)
+    {
+        if (entry.m_valid && entry.m_address == line_address && entry.m_set->Touch(entry.m_way, line_address, operation, m_clock.GetCycle()))
+        {
+            if (operation == Operation::STORE)
+            {
+                set_t const set = entry.m_set->GetIndex();
+                m_dirty_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+            }
+
+            Retire();
+            return;
+        }
+    }
+
     // Parse address.
     auto [full_address, tag, set] = ParseAddress(address);
+    CacheSet* cache_set = GetSet(set);
 
     // Perform operation.
-    switch (operation)
+    timestamp_t const cycle = m_clock.GetCycle();
+    way_t const way = (operation == Operation::LOAD) ? cache_set->Load(full_address, tag, cycle, m_sink) : cache_set->Store(full_address, tag, cycle, m_sink);
+
+    RecordL0(full_address, cache_set, way);
+
+    // Update the summaries.
+    m_occupied_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+    if (operation == Operation::STORE)
+        m_dirty_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+
+    Retire();
+}
+
+void Cache::PerformStore(address_t const address)
+{
+    auto [full_address, tag, set] = ParseAddress(address);
+    CacheSet* cache_set = GetSet(set);
+    timestamp_t const cycle = m_clock.GetCycle();
+
+    // Streaming stores go around the cache. A cached copy is written back, if dirty, and invalidated.
+    if (c_streaming_stores)
     {
-        case Operation::LOAD:
-            m_sets[set]->Load(full_address, tag);
-            break;
-        case Operation::STORE:
-            m_sets[set]->Store(full_address, tag);
-            break;
-        default:
-            throw std::invalid_argument("Unknown cache operation.");
+        cache_set->Invalidate(full_address, cycle, m_sink);
+        m_sink.Store(full_address, cycle);
+        return;
+    }
+
+    // Without write-allocate, a store miss goes to memory and leaves the cache untouched.
+    if (!c_write_allocate && cache_set->Find(full_address) == NO_WAY)
+    {
+        m_sink.Store(full_address, cycle);
+        return;
+    }
+
+    // Write-through stores hit (or fill) the line like loads, and go to memory as well.
+    way_t const way = c_write_through ? cache_set->Load(full_address, tag, cycle, m_sink) : cache_set->Store(full_address, tag, cycle, m_sink);
+    RecordL0(full_address, cache_set, way);
+
+    m_occupied_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+
+    if (c_write_through)
+        m_sink.Store(full_address, cycle);
+    else
+        m_dirty_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+}
+
+void Cache::Retire()
+{
+    // Increment the clock.
+    m_clock.Increment();
+
+    // End of an epoch.
+    if (c_flush_interval != 0 && --m_epoch_remaining == 0)
+    {
+        m_epoch_remaining = c_flush_interval;
+        FlushPoint();
     }
+}
+
+void Cache::FlushPoint()
+{
+    if (c_flush_mode == FlushMode::WRITEBACK)
+        Writeback();
+    else
+        Flush();
+}
 
-    // Increment global clock.
-    GlobalClock::Increment();
+template <typename Function>
+void Cache::ForEachMarkedSet(std::vector<std::uint64_t> const& summary, Function function)
+{
+    for (std::size_t word = 0; word < summary.size(); ++word)
+        for (std::uint64_t bits = summary[word]; bits != 0; bits &= bits - 1)
+            function(word * 64 + __builtin_ctzll(bits));
+}
+
+void Cache::PerformOperations(MemoryAccess const* accesses, std::size_t const count)
+{
+    std::size_t const distance = c_prefetch_distance;
+
+    if (distance == 0)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            PerformOperation(accesses[i].m_operation, accesses[i].m_address);
+
+        return;
+    }
+
+    // Software pipeline over a window of decoded set indices. An access is decoded and its CacheSet is
+    // constructed if needed and prefetched 2 * distance accesses ahead, the lines of the set are prefetched
+    // distance accesses ahead, and the accesses are performed in their original order. Prefetches do not
+    // change any state, so the output is identical to the sequential loop.
+    std::size_t const lead = 2 * distance;
+    constexpr std::size_t c_window_mask = 2 * MAX_PREFETCH_DISTANCE - 1;
+    std::array<set_t, c_window_mask + 1> window;
+
+    auto const decode = [&](std::size_t const i)
+    {
+        set_t const set = static_cast<set_t>((accesses[i].m_address >> c_set_shift) & c_set_mask);
+        window[i & c_window_mask] = set;
+        __builtin_prefetch(GetSet(set));
+    };
+
+    // Fill the pipeline.
+    for (std::size_t i = 0; i < std::min(lead, count); ++i)
+        decode(i);
+
+    for (std::size_t i = 0; i < std::min(distance, count); ++i)
+        SetAt(window[i & c_window_mask])->Prefetch(accesses[i].m_address);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Perform first: the window slot of this access is reused by the decode below.
+        PerformOperation(accesses[i].m_operation, accesses[i].m_address);
+
+        if (i + distance < count)
+            SetAt(window[(i + distance) & c_window_mask])->Prefetch(accesses[i + distance].m_address);
+
+        if (i + lead < count)
+            decode(i + lead);
+    }
+}
+
+void Cache::InitializeSet(set_t const set)
+{
+    char* const slot = m_set_base + set * c_set_stride;
+    new (slot) CacheSet(static_cast<way_t>(c_way_count), set, slot + c_set_header);
+
+    m_initialized_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+}
+
+void Cache::RecordL0(address_t const address, CacheSet* set, way_t const way)
+{
+    // Refresh a stale entry for the same line, otherwise replace round-robin.
+    for (L0Entry& entry : m_l0)
+    {
+        if (entry.m_valid && entry.m_address == address)
+        {
+            entry.m_set = set;
+            entry.m_way = way;
+            return;
+        }
+    }
+
+    m_l0[m_l0_next] = {address, set, way, true};
+    m_l0_next = (m_l0_next + 1) % c_l0_size;
 }
 
 std::tuple<address_t, tag_t, set_t> Cache::ParseAddress(address_t address) const
@@ -88,16 +305,25 @@ std::tuple<address_t, tag_t, set_t> Cache::ParseAddress(address_t address) const
 
 void Cache::Flush()
 {
-    // Flush all cache sets.
-    for (auto set : m_sets)
-        set->Flush();
+    // Flush the sets that hold lines, in set order. The others have nothing to write back or invalidate.
+    timestamp_t const cycle = m_clock.GetCycle();
+    ForEachMarkedSet(m_occupied_sets, [&](std::size_t const set) { SetAt(set)->Flush(cycle, m_sink); });
+
+    std::fill(m_occupied_sets.begin(), m_occupied_sets.end(), 0);
+    std::fill(m_dirty_sets.begin(), m_dirty_sets.end(), 0);
+}
+
+void Cache::Writeback()
+{
+    // Write back the sets that may hold dirty lines, in set order.
+    timestamp_t const cycle = m_clock.GetCycle();
+    ForEachMarkedSet(m_dirty_sets, [&](std::size_t const set) { SetAt(set)->Writeback(cycle, m_sink); });
+
+    std::fill(m_dirty_sets.begin(), m_dirty_sets.end(), 0);
 }
 
 Cache::~Cache()
 {
-    // Destructor: Flush the cache and deallocate sets.
+    // Destructor: Flush the cache. The sets hold no resources of their own, so unmapping the arena releases them.
     Flush();
-    
-    for (auto set : m_sets)
-        delete set;
 }
\ No newline at end of file
@@ -12,20 +12,54 @@
 
 #include <core/cache_components.h>
 
-#include <utils/clock.h>
-#include <utils/trace_engine.h>
-
+#include <algorithm>
+#include <cmath>
+#include <new>
 #include <stdexcept>
 
-CacheSet::CacheSet(way_t ways, set_t set) : c_ways_count(ways), c_set_index(set)
+namespace
+{
+    // Hash table slots of a hashed set: a power of 2 with a load factor of at most 50%.
+    std::size_t GetTableSlots(way_t ways)
+    {
+        std::size_t slots = 1;
+        while (slots < 2 * static_cast<std::size_t>(ways))
+            slots <<= 1;
+
+        return slots;
+    }
+
+    // Words of the dirty mask of a set.
+    std::size_t GetDirtyWords(way_t ways)
+    {
+        return (static_cast<std::size_t>(ways) + 63) / 64;
+    }
+}
+
+CacheSet::CacheSet(way_t ways, set_t set, void* storage) :
+        c_ways_count(ways),
+        c_set_index(set),
+        m_mru_way(0),
+        m_dirty_mask(&m_dirty_word),
+        m_dirty_word(0),
+        c_hashed(ways >= HASHED_SET_MIN_WAYS),
+        m_table(nullptr),
+        m_table_mask(0),
+        m_table_shift(0),
+        m_lru_head(NO_WAY),
+        m_lru_tail(NO_WAY),
+        m_valid_count(0)
 {
-    // Allocate ways.
-    m_ways = new CacheLine[c_ways_count];
+    // Carve the ways, the dirty mask of large sets and the table out of the storage, in that order.
+    char* next = static_cast<char*>(storage);
+
+    m_ways = reinterpret_cast<CacheLine*>(next);
+    next += c_ways_count * sizeof(CacheLine);
 
     // Initializes the ways to invalid.
     for (way_t way = 0; way < c_ways_count; ++way)
     {
-        CacheLine& line = m_ways[way];
+        CacheLine& line = *new (&m_ways[way]) CacheLine;
         line.m_address = 0;
         line.m_tag = 0;
         line.m_way = way;
@@ -34,27 +68,82 @@ CacheSet::CacheSet(way_t ways, set_t set) : c_ways_count(ways), c_set_index(set)
         line.m_dirty = false;
 
         line.m_last_access = 0;
+
+        line.m_lru_prev = NO_WAY;
+        line.m_lru_next = NO_WAY;
+    }
+
+    // Large sets keep their dirty mask in the storage.
+    if (c_ways_count > 64)
+    {
+        m_dirty_mask = reinterpret_cast<std::uint64_t*>(next);
+        std::fill_n(m_dirty_mask, GetDirtyWords(c_ways_count), 0);
+        next += GetDirtyWords(c_ways_count) * sizeof(std::uint64_t);
+    }
+
+    // Hashed sets: an empty table.
+    if (c_hashed)
+    {
+        std::size_t const slots = GetTableSlots(c_ways_count);
+
+        m_table = reinterpret_cast<way_t*>(next);
+        std::fill_n(m_table, slots, 0);
+        m_table_mask = slots - 1;
+        m_table_shift = 64 - static_cast<unsigned>(log2(slots));
     }
 }
 
-void CacheSet::Load(address_t const address, tag_t const tag)
+way_t CacheSet::Load(address_t const address, tag_t const tag, timestamp_t const cycle, MemorySink& sink)
 {
-    // Load the line and update the last access timestamp.
-    CacheLine& way = LocateAndAllocate(address, tag);
-    way.m_last_access = GlobalClock::GetCycle();
-    
+    // Load the line and update the replacement state.
+    CacheLine& way = LocateAndAllocate(address, tag, cycle, sink);
+    Promote(way.m_way, cycle);
+
+    return way.m_way;
 }
 
-void CacheSet::Store(address_t const address, tag_t const tag)
+way_t CacheSet::Store(address_t const address, tag_t const tag, timestamp_t const cycle, MemorySink& sink)
 {
-    // Load the line, update the last access timestamp, and mark it as dirty.
-    CacheLine& way = LocateAndAllocate(address, tag);
-    way.m_dirty = true;
-    way.m_last_access = GlobalClock::GetCycle();
-    
+    // Load the line, update the replacement state, and mark it as dirty.
+    CacheLine& way = LocateAndAllocate(address, tag, cycle, sink);
+    if (!way.m_dirty)
+        MarkDirty(way.m_way);
+    Promote(way.m_way, cycle);
+
+    return way.m_way;
+}
+
+bool CacheSet::Touch(way_t const way, address_t const address, Operation const operation, timestamp_t const cycle)
+{
+    CacheLine& line = m_ways[way];
+
+    // The line may have been evicted since the way was recorded.
+    if (!line.m_valid || line.m_address != address)
+        return false;
+
+    // Same state updates as a Load or Store hit.
+    if (operation == Operation::STORE && !line.m_dirty)
+        MarkDirty(way);
+
+    Promote(way, cycle);
+    return true;
+}
+
+void CacheSet::Promote(way_t const way, timestamp_t const cycle)
+{
+    // Update the last access timestamp and the way prediction.
+    m_ways[way].m_last_access = cycle;
+    m_mru_way = way;
+
+    // Hashed sets: move the way to the MRU end of the list.
+    if (c_hashed && m_lru_head != way)
+    {
+        ListUnlink(way);
+        ListPushFront(way);
+    }
 }
 
-CacheLine& CacheSet::LocateAndAllocate(address_t const address, tag_t const tag)
+CacheLine& CacheSet::LocateAndAllocate(address_t const address, tag_t const tag, timestamp_t const cycle, MemorySink& sink)
 {
     // Check if the address is already present.
     way_t way = IsPresent(address);
@@ -62,20 +151,34 @@ CacheLine& CacheSet::LocateAndAllocate(address_t const address, tag_t const tag)
     // Found the address in the set.
     if (way != NO_WAY)
         return m_ways[way];
-    
-    // Look for an empty way first.
-    for (way_t i = 0; i < c_ways_count; ++i)
+
+    if (c_hashed)
     {
-        if (!m_ways[i].m_valid)
+        // Invalid ways form a suffix: take the next one, or evict the LRU way.
+        if (m_valid_count < c_ways_count)
         {
-            way = i;
-            break;
+            way = m_valid_count++;
+            ListPushFront(way);
         }
+        else
+            way = EvictLRU(cycle, sink);
     }
+    else
+    {
+        // Look for an empty way first.
+        for (way_t i = 0; i < c_ways_count; ++i)
+        {
+            if (!m_ways[i].m_valid)
+            {
+                way = i;
+                break;
+            }
+        }
 
-    // If there are no empty lines, we need to evict one.
-    if (way == NO_WAY)
-        way = EvictLRU();
+        // If there are no empty lines, we need to evict one.
+        if (way == NO_WAY)
+            way = EvictLRU(cycle, sink);
+    }
 
     // Allocate the new line.
     CacheLine& line = m_ways[way];
@@ -86,46 +189,141 @@ CacheLine& CacheSet::LocateAndAllocate(address_t const address, tag_t const tag)
     line.m_valid = true;
     line.m_dirty = false;
 
+    if (c_hashed)
+        HashInsert(way);
+
     // Issue a Load.
-    TraceEngine::Load(line.m_address);
+    sink.Load(line.m_address, cycle);
 
     return line;
 }
 
-way_t CacheSet::EvictLRU()
+way_t CacheSet::EvictLRU(timestamp_t const cycle, MemorySink& sink)
 {
     // Find the least recently used way.
     way_t lru_way = 0;
-    timestamp_t lru_timestamp = TIMESTAMP_MAX;
 
-    // For each way, find the one with the smallest last access timestamp.
-    for (way_t i = 0; i < c_ways_count; ++i)
+    if (c_hashed)
     {
-        CacheLine const& line = m_ways[i];
+        // The LRU way is the tail of the list. It stays linked: the caller reuses it right away.
+        lru_way = m_lru_tail;
+        HashErase(lru_way);
+    }
+    else
+    {
+        timestamp_t lru_timestamp = TIMESTAMP_MAX;
+
+        // For each way, find the one with the smallest last access timestamp.
+        for (way_t i = 0; i < c_ways_count; ++i)
+        {
+            CacheLine const& line = m_ways[i];
 
-        // Sanity check: all lines should be valid.
-        if (!line.m_valid)
-            throw std::runtime_error("EvictLRU called on non-full set.");
+            // Sanity check: all lines should be valid.
+            if (!line.m_valid)
+                throw std::runtime_error("EvictLRU called on non-full set.");
 
-        if (line.m_last_access < lru_timestamp)
-            lru_way = line.m_way;
+            if (line.m_last_access < lru_timestamp)
+            {
+                lru_way = line.m_way;
+                lru_timestamp = line.m_last_access;
+            }
+        }
     }
     
     CacheLine& line = m_ways[lru_way];
 
-    // Issue a load if the previous line was dirty.
+    // Issue a store if the previous line was dirty.
     if (line.m_dirty)
-        TraceEngine::Store(line.m_address);
+    {
+        sink.Store(line.m_address, cycle);
+        MarkClean(lru_way);
+    }
 
-    // Set valid and dirty to false.
+    // Set valid to false.
     line.m_valid = false;
-    line.m_dirty = false;
 
     return lru_way;
 }
 
+bool CacheSet::Invalidate(address_t const address, timestamp_t const cycle, MemorySink& sink)
+{
+    way_t const way = IsPresent(address);
+
+    if (way == NO_WAY)
+        return false;
+
+    // Write back the line if it was dirty.
+    if (m_ways[way].m_dirty)
+    {
+        sink.Store(m_ways[way].m_address, cycle);
+        MarkClean(way);
+    }
+
+    if (!c_hashed)
+    {
+        m_ways[way].m_valid = false;
+        return true;
+    }
+
+    // Hashed sets keep the invalid ways as a suffix: the last valid way moves into the hole.
+    HashErase(way);
+    ListUnlink(way);
+
+    way_t const last = --m_valid_count;
+
+    if (way != last)
+    {
+        CacheLine& line = m_ways[way];
+        CacheLine const& moved = m_ways[last];
+
+        line.m_address = moved.m_address;
+        line.m_tag = moved.m_tag;
+        line.m_last_access = moved.m_last_access;
+        line.m_lru_prev = moved.m_lru_prev;
+        line.m_lru_next = moved.m_lru_next;
+
+        // Relink the neighbours of the moved way.
+        if (line.m_lru_prev != NO_WAY)
+            m_ways[line.m_lru_prev].m_lru_next = way;
+        else
+            m_lru_head = way;
+
+        if (line.m_lru_next != NO_WAY)
+            m_ways[line.m_lru_next].m_lru_prev = way;
+        else
+            m_lru_tail = way;
+
+        HashReplace(last, way);
+
+        if (moved.m_dirty)
+        {
+            MarkClean(last);
+            MarkDirty(way);
+        }
+
+        if (m_mru_way == last)
+            m_mru_way = way;
+    }
+
+    CacheLine& hole = m_ways[last];
+    hole.m_valid = false;
+    hole.m_lru_prev = NO_WAY;
+    hole.m_lru_next = NO_WAY;
+
+    return true;
+}
+
 way_t CacheSet::IsPresent(address_t const address) const
 {
+    // Way prediction: check the most recently used way first.
+    CacheLine const& mru_line = m_ways[m_mru_way];
+    if (mru_line.m_valid && mru_line.m_address == address)
+        return m_mru_way;
+
+    // Hashed sets: probe the table.
+    if (c_hashed)
+        return HashFind(address);
+
     // Check each way for the address.
     for (way_t i = 0; i < c_ways_count; ++i)
     {
@@ -138,25 +336,157 @@ way_t CacheSet::IsPresent(address_t const address) const
     return NO_WAY;
 }
 
-void CacheSet::Flush()
+std::size_t CacheSet::HashSlot(address_t const address) const
 {
-    // For each way, if valid and dirty, issue a store.
-    for (way_t i = 0; i < c_ways_count; ++i)
+    // Fibonacci hashing: the high bits of the product are well mixed.
+    return static_cast<std::size_t>((address * 0x9E3779B97F4A7C15ull) >> m_table_shift) & m_table_mask;
+}
+
+way_t CacheSet::HashFind(address_t const address) const
+{
+    // Linear probing until an empty slot.
+    for (std::size_t slot = HashSlot(address); m_table[slot] != 0; slot = (slot + 1) & m_table_mask)
     {
-        CacheLine& line = m_ways[i];
+        way_t const way = m_table[slot] - 1;
+        if (m_ways[way].m_address == address)
+            return way;
+    }
+
+    return NO_WAY;
+}
+
+void CacheSet::HashInsert(way_t const way)
+{
+    std::size_t slot = HashSlot(m_ways[way].m_address);
+    while (m_table[slot] != 0)
+        slot = (slot + 1) & m_table_mask;
+
+    m_table[slot] = way + 1;
+}
+
+void CacheSet::HashErase(way_t const way)
+{
+    // Locate the slot holding the way.
+    std::size_t hole = HashSlot(m_ways[way].m_address);
+    while (m_table[hole] != way + 1)
+        hole = (hole + 1) & m_table_mask;
+
+    // Shift back the following entries of the cluster that would become unreachable.
+    for (std::size_t slot = (hole + 1) & m_table_mask; m_table[slot] != 0; slot = (slot + 1) & m_table_mask)
+    {
+        std::size_t const home = HashSlot(m_ways[m_table[slot] - 1].m_address);
+
+        // The entry can move to the hole if its home is not cyclically within (hole, slot].
+        if (((slot - home) & m_table_mask) >= ((slot - hole) & m_table_mask))
+        {
+            m_table[hole] = m_table[slot];
+            hole = slot;
+        }
+    }
+
+    m_table[hole] = 0;
+}
+
+void CacheSet::HashReplace(way_t const way, way_t const new_way)
+{
+    std::size_t slot = HashSlot(m_ways[way].m_address);
+    while (m_table[slot] != way + 1)
+        slot = (slot + 1) & m_table_mask;
+
+    m_table[slot] = new_way + 1;
+}
+
+void CacheSet::ListUnlink(way_t const way)
+{
+    CacheLine& line = m_ways[way];
+
+    if (line.m_lru_prev != NO_WAY)
+        m_ways[line.m_lru_prev].m_lru_next = line.m_lru_next;
+    else
+        m_lru_head = line.m_lru_next;
 
-        if (line.m_valid && line.m_dirty)
-            TraceEngine::Store(line.m_address);
+    if (line.m_lru_next != NO_WAY)
+        m_ways[line.m_lru_next].m_lru_prev = line.m_lru_prev;
+    else
+        m_lru_tail = line.m_lru_prev;
+
+    line.m_lru_prev = NO_WAY;
+    line.m_lru_next = NO_WAY;
+}
+
+void CacheSet::ListPushFront(way_t const way)
+{
+    CacheLine& line = m_ways[way];
+
+    line.m_lru_prev = NO_WAY;
+    line.m_lru_next = m_lru_head;
+
+    if (m_lru_head != NO_WAY)
+        m_ways[m_lru_head].m_lru_prev = way;
+    else
+        m_lru_tail = way;
+
+    m_lru_head = way;
+}
+
+void CacheSet::MarkDirty(way_t const way)
+{
+    m_ways[way].m_dirty = true;
+    m_dirty_mask[way >> 6] |= std::uint64_t(1) << (way & 63);
+}
+
+void CacheSet::MarkClean(way_t const way)
+{
+    m_ways[way].m_dirty = false;
+    m_dirty_mask[way >> 6] &= ~(std::uint64_t(1) << (way & 63));
+}
+
+void CacheSet::Writeback(timestamp_t const cycle, MemorySink& sink)
+{
+    // Only dirty ways are visited. Dirty ways are always valid.
+    ForEachDirty([&](way_t const way)
+    {
+        sink.Store(m_ways[way].m_address, cycle);
+        MarkClean(way);
+    });
+}
+
+void CacheSet::Flush(timestamp_t const cycle, MemorySink& sink)
+{
+    // Issue a store for each dirty way.
+    Writeback(cycle, sink);
+
+    // Invalidate the ways. Hashed sets only hold valid ways in [0, m_valid_count).
+    way_t const used = c_hashed ? m_valid_count : c_ways_count;
+
+    for (way_t i = 0; i < used; ++i)
+    {
+        CacheLine& line = m_ways[i];
 
-        // Set valid and dirty to false.
         line.m_valid = false;
-        line.m_dirty = false;
+        line.m_lru_prev = NO_WAY;
+        line.m_lru_next = NO_WAY;
+    }
+
+    // Hashed sets: empty the table and the LRU list.
+    if (c_hashed)
+    {
+        std::fill(m_table, m_table + m_table_mask + 1, 0);
+        m_lru_head = NO_WAY;
+        m_lru_tail = NO_WAY;
+        m_valid_count = 0;
     }
 }
 
-CacheSet::~CacheSet()
+std::size_t CacheSet::GetStorageSize(way_t ways)
 {
-    // Destructor: Flush the cache set and deallocate ways.
-    Flush();
-    delete[] m_ways;
+    std::size_t size = ways * sizeof(CacheLine);
+
+    if (ways > 64)
+        size += GetDirtyWords(ways) * sizeof(std::uint64_t);
+
+    if (ways >= HASHED_SET_MIN_WAYS)
+        size += GetTableSlots(ways) * sizeof(way_t);
+
+    return size;
 }
@@ -0,0 +1,42 @@
+/**
+ * @file      cache_model.cpp
+ * @brief     Cache organization factory.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <core/cache_model.h>
+
+#include <core/cache.h>
+#include <core/sectored_cache.h>
+#include <core/timed_cache.h>
+#include <core/translated_cache.h>
+
+std::unique_ptr<CacheModel> CreateCacheOrganization(Config const& config, MemorySink& sink)
+{
+    if (config.m_organization == CacheOrganization::SECTORED)
+        return std::make_unique<SectoredCache>(config, sink);
+
+    return std::make_unique<Cache>(config, sink);
+}
+
+std::unique_ptr<CacheModel> CreateCacheModel(Config const& config, MemorySink& sink)
+{
+    // Issue timing sees the translated accesses, page-walk loads included.
+    std::unique_ptr<CacheModel> cache;
+
+    if (config.m_issue_timing != IssueTiming::ACCESS)
+        cache = std::make_unique<TimedCache>(config, sink);
+    else
+        cache = CreateCacheOrganization(config, sink);
+
+    if (config.m_translation)
+        return std::make_unique<TranslatedCache>(config, std::move(cache));
+
+    return cache;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file      sectored_cache.cpp
+ * @brief     Sectored cache class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <core/sectored_cache.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    // Validate the geometry before any member is sized from it.
+    std::size_t CheckedSectors(std::size_t sets, std::size_t ways, std::size_t block_size, std::size_t sector_size, unsigned address_bits)
+    {
+        if (!IsPow2(sets) || !IsPow2(ways) || !IsPow2(block_size) || !IsPow2(sector_size))
+            throw std::invalid_argument("Sectored cache sets, ways, block size and sector size must be powers of 2.");
+
+        if (ways > SectoredCache::c_max_ways)
+            throw std::invalid_argument("Sectored caches support at most " + std::to_string(SectoredCache::c_max_ways) + " ways.");
+
+        if (sector_size > block_size || block_size / sector_size > SectoredCache::c_max_sectors)
+            throw std::invalid_argument("Sectored cache blocks must hold between 1 and " + std::to_string(SectoredCache::c_max_sectors) + " sectors.");
+
+        if (address_bits > 64 || address_bits <= log2(block_size) + log2(sets))
+            throw std::invalid_argument("Sectored cache address width must leave room for a tag and be at most 64 bits.");
+
+        return block_size / sector_size;
+    }
+}
+
+SectoredCache::SectoredCache(std::size_t sets, std::size_t ways, std::size_t block_size, std::size_t sector_size, unsigned address_bits, MemorySink& sink,
+                             std::size_t prefetch_distance, std::uint64_t flush_interval, FlushMode flush_mode) :
+        c_set_count(sets),
+        c_way_count(ways),
+        c_block_size(block_size),
+        c_sector_size(sector_size),
+        c_sectors_per_block(CheckedSectors(sets, ways, block_size, sector_size, address_bits)),
+        c_address_bits(address_bits),
+        c_sector_shift(static_cast<address_t>(log2(sector_size))),
+        c_set_shift(static_cast<address_t>(log2(block_size))),
+        c_tag_shift(static_cast<address_t>(log2(sets)) + c_set_shift),
+        c_set_mask(sets - 1),
+        c_address_overflow_mask(address_bits == 64 ? 0 : ~((address_t(1) << address_bits) - 1)),
+        c_prefetch_distance(prefetch_distance),
+        c_flush_interval(flush_interval),
+        c_flush_mode(flush_mode),
+        m_tags(sets * ways, static_cast<unsigned>(address_bits - c_tag_shift + 1)),
+        m_valid_sectors(sets * ways, static_cast<unsigned>(c_sectors_per_block)),
+        m_dirty_sectors(sets * ways, static_cast<unsigned>(c_sectors_per_block)),
+        m_lru_stacks(ways > 1 ? sets : 0, InitialLRUStack()),
+        m_sink(sink),
+        m_epoch_remaining(flush_interval),
+        m_occupied_sets((sets + 63) / 64, 0),
+        m_dirty_sets((sets + 63) / 64, 0)
+{
+    if (c_prefetch_distance > MAX_PREFETCH_DISTANCE)
+        throw std::invalid_argument("Sectored cache prefetch distance must be at most " + std::to_string(MAX_PREFETCH_DISTANCE) + ".");
+}
+
+SectoredCache::SectoredCache(Config const& config, MemorySink& sink) :
+        SectoredCache(config.m_sets, config.m_ways, config.m_line_size, config.m_sector_size, config.m_address_bits, sink, config.m_prefetch_distance,
+                      config.m_flush_interval, config.m_flush_mode)
+{
+}
+
+SectoredCache::~SectoredCache()
+{
+    // Destructor: Write back the dirty sectors.
+    Flush();
+}
+
+void SectoredCache::PrintConfiguration(std::ostream& stream) const
+{
+    std::size_t const capacity = c_set_count * c_way_count * c_block_size;
+    std::size_t const metadata = GetMetadataBytes();
+
+    stream << "Sectored Cache: " << std::endl;
+    stream << "    Sets:       " << c_set_count << std::endl;
+    stream << "    Ways:       " << c_way_count << std::endl;
+    stream << "    Block size: " << c_block_size << " bytes" << std::endl;
+    stream << "    Sector:     " << c_sector_size << " bytes (" << c_sectors_per_block << " per block)" << std::endl;
+    stream << "    Cache size: " << capacity << " bytes" << std::endl;
+    stream << std::endl;
+    stream << "    Tag bits:   " << m_tags.GetWidth() - 1 << " (" << c_address_bits << "-bit addresses)" << std::endl;
+    stream << "    Metadata:   " << metadata << " bytes (" << metadata / std::max<std::size_t>(1, capacity >> 20) << " bytes per MiB)" << std::endl;
+}
+
+std::size_t SectoredCache::GetMetadataBytes() const
+{
+    return m_tags.GetBytes() + m_valid_sectors.GetBytes() + m_dirty_sectors.GetBytes() + m_lru_stacks.size() * sizeof(std::uint64_t);
+}
+
+void SectoredCache::PerformOperation(Operation const operation, address_t const address)
+{
+    if (operation != Operation::LOAD && operation != Operation::STORE)
+    {
+        if (operation != Operation::FLUSH)
+            throw std::invalid_argument("Unknown cache operation.");
+
+        FlushPoint();
+        return;
+    }
+
+    if (address & c_address_overflow_mask)
+    {
+        std::ostringstream message;
+        message << "Address 0x" << std::hex << address << " does not fit in the " << std::dec << c_address_bits << "-bit address width of the sectored cache.";
+        throw std::out_of_range(message.str());
+    }
+
+    // Parse address. The stored tag is offset by one so that zero can mark an invalid block.
+    std::size_t const set = (address >> c_set_shift) & c_set_mask;
+    std::size_t const sector = (address >> c_sector_shift) & (c_sectors_per_block - 1);
+    std::uint64_t const tag_field = (address >> c_tag_shift) + 1;
+    std::size_t const first_line = set * c_way_count;
+    timestamp_t const cycle = m_clock.GetCycle();
+
+    // Look for the block, remembering the first invalid way.
+    way_t way = NO_WAY;
+    way_t free_way = NO_WAY;
+
+    for (way_t i = 0; i < c_way_count; ++i)
+    {
+        std::uint64_t const stored = m_tags.Get(first_line + i);
+
+        if (stored == tag_field)
+        {
+            way = i;
+            break;
+        }
+
+        if (stored == 0 && free_way == NO_WAY)
+            free_way = i;
+    }
+
+    // Block miss: take an invalid way or evict the LRU block, then allocate it without any sector.
+    if (way == NO_WAY)
+    {
+        if (free_way != NO_WAY)
+            way = free_way;
+        else
+        {
+            way = GetLRUWay(set);
+            Evict(set, way, cycle);
+        }
+
+        m_tags.Set(first_line + way, tag_field);
+    }
+
+    std::size_t const line = first_line + way;
+    std::uint64_t const sector_bit = std::uint64_t(1) << sector;
+
+    // Sector miss: fetch only the accessed sector.
+    std::uint64_t const valid = m_valid_sectors.Get(line);
+    if (!(valid & sector_bit))
+    {
+        m_sink.Load(SectorAddress(tag_field, set, sector), cycle);
+        m_valid_sectors.Set(line, valid | sector_bit);
+    }
+
+    if (operation == Operation::STORE)
+    {
+        m_dirty_sectors.Set(line, m_dirty_sectors.Get(line) | sector_bit);
+        m_dirty_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+    }
+
+    m_occupied_sets[set >> 6] |= std::uint64_t(1) << (set & 63);
+    Promote(set, way);
+
+    // Increment the clock.
+    m_clock.Increment();
+
+    // End of an epoch.
+    if (c_flush_interval != 0 && --m_epoch_remaining == 0)
+    {
+        m_epoch_remaining = c_flush_interval;
+        FlushPoint();
+    }
+}
+
+void SectoredCache::FlushPoint()
+{
+    if (c_flush_mode == FlushMode::WRITEBACK)
+        Writeback();
+    else
+        Flush();
+}
+
+void SectoredCache::PerformOperations(MemoryAccess const* accesses, std::size_t const count)
+{
+    std::size_t const distance = c_prefetch_distance;
+
+    // The metadata is flat, so one stage is enough: prefetch the set distance accesses ahead. Prefetches
+    // do not change any state, so the output is identical to the sequential loop.
+    for (std::size_t i = 0; distance != 0 && i < std::min(distance, count); ++i)
+        PrefetchSet(accesses[i].m_address);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (distance != 0 && i + distance < count)
+            PrefetchSet(accesses[i + distance].m_address);
+
+        PerformOperation(accesses[i].m_operation, accesses[i].m_address);
+    }
+}
+
+void SectoredCache::PrefetchSet(address_t const address) const
+{
+    std::size_t const set = (address >> c_set_shift) & c_set_mask;
+    std::size_t const first_line = set * c_way_count;
+
+    m_tags.Prefetch(first_line);
+    m_valid_sectors.Prefetch(first_line);
+    m_dirty_sectors.Prefetch(first_line);
+
+    if (!m_lru_stacks.empty())
+        __builtin_prefetch(&m_lru_stacks[set]);
+}
+
+void SectoredCache::Flush()
+{
+    timestamp_t const cycle = m_clock.GetCycle();
+
+    // Flush the sets that hold blocks, way by way, in set order.
+    for (std::size_t word = 0; word < m_occupied_sets.size(); ++word)
+    {
+        for (std::uint64_t bits = m_occupied_sets[word]; bits != 0; bits &= bits - 1)
+        {
+            std::size_t const set = word * 64 + __builtin_ctzll(bits);
+
+            for (way_t way = 0; way < c_way_count; ++way)
+                if (m_tags.Get(set * c_way_count + way) != 0)
+                    Evict(set, way, cycle);
+
+            if (!m_lru_stacks.empty())
+                m_lru_stacks[set] = InitialLRUStack();
+        }
+    }
+
+    std::fill(m_occupied_sets.begin(), m_occupied_sets.end(), 0);
+    std::fill(m_dirty_sets.begin(), m_dirty_sets.end(), 0);
+}
+
+void SectoredCache::Writeback()
+{
+    timestamp_t const cycle = m_clock.GetCycle();
+
+    // Write back the sets that may hold dirty sectors, way by way, in set order.
+    for (std::size_t word = 0; word < m_dirty_sets.size(); ++word)
+    {
+        for (std::uint64_t bits = m_dirty_sets[word]; bits != 0; bits &= bits - 1)
+        {
+            std::size_t const set = word * 64 + __builtin_ctzll(bits);
+
+            for (way_t way = 0; way < c_way_count; ++way)
+                WritebackWay(set, way, cycle);
+        }
+    }
+
+    std::fill(m_dirty_sets.begin(), m_dirty_sets.end(), 0);
+}
+
+void SectoredCache::Promote(std::size_t const set, way_t const way)
+{
+    if (m_lru_stacks.empty())
+        return;
+
+    std::uint64_t const stack = m_lru_stacks[set];
+    if ((stack & 0xF) == way)
+        return;
+
+    // Find the position of the way and move it to the top, shifting the more recent ways down by one.
+    unsigned position = 1;
+    while (((stack >> (4 * position)) & 0xF) != way)
+        ++position;
+
+    std::uint64_t const above = stack & ((std::uint64_t(1) << (4 * position)) - 1);
+    std::uint64_t const below = (position == 15) ? 0 : stack & ~((std::uint64_t(1) << (4 * (position + 1))) - 1);
+
+    m_lru_stacks[set] = below | (above << 4) | way;
+}
+
+way_t SectoredCache::GetLRUWay(std::size_t const set) const
+{
+    if (m_lru_stacks.empty())
+        return 0;
+
+    return static_cast<way_t>((m_lru_stacks[set] >> (4 * (c_way_count - 1))) & 0xF);
+}
+
+void SectoredCache::Evict(std::size_t const set, way_t const way, timestamp_t const cycle)
+{
+    std::size_t const line = set * c_way_count + way;
+
+    WritebackWay(set, way, cycle);
+    m_tags.Set(line, 0);
+    m_valid_sectors.Set(line, 0);
+}
+
+void SectoredCache::WritebackWay(std::size_t const set, way_t const way, timestamp_t const cycle)
+{
+    std::size_t const line = set * c_way_count + way;
+    std::uint64_t const dirty_sectors = m_dirty_sectors.Get(line);
+
+    if (dirty_sectors == 0)
+        return;
+
+    // Issue a store for every dirty sector, in address order.
+    std::uint64_t const tag_field = m_tags.Get(line);
+    for (std::uint64_t dirty = dirty_sectors; dirty != 0; dirty &= dirty - 1)
+        m_sink.Store(SectorAddress(tag_field, set, __builtin_ctzll(dirty)), cycle);
+
+    m_dirty_sectors.Set(line, 0);
+}
+
+address_t SectoredCache::SectorAddress(std::uint64_t const tag_field, std::size_t const set, std::size_t const sector) const
+{
+    return ((tag_field - 1) << c_tag_shift) | (static_cast<address_t>(set) << c_set_shift) | (static_cast<address_t>(sector) << c_sector_shift);
+}
+
+std::uint64_t SectoredCache::InitialLRUStack() const
+{
+    std::uint64_t stack = 0;
+    for (std::size_t way = 0; way < c_way_count; ++way)
+        stack |= static_cast<std::uint64_t>(way) << (4 * way);
+
+    return stack;
+}
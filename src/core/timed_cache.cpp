@@ -0,0 +1,127 @@
+/**
+ * @file      timed_cache.cpp
+ * @brief     Timed cache class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <core/timed_cache.h>
+
+#include <cmath>
+#include <iostream>
+
+TimedCache::TimedCache(Config const& config, MemorySink& sink) :
+        c_timing(config.m_issue_timing),
+        c_access_period(std::llround(std::ldexp(1.0 / config.m_accesses_per_cycle, c_fraction_bits))),
+        c_instruction_period(std::llround(std::ldexp(config.m_cycles_per_instruction, c_fraction_bits))),
+        c_hit_latency(config.m_hit_latency),
+        m_stage(*this, sink),
+        m_time(0),
+        m_trace_cycle(0),
+        m_first_position(0),
+        m_cache(CreateCacheOrganization(config, m_stage))
+{
+    // A TLB miss adds at most a 4-level walk to an access.
+    m_request_cycles.reserve(ACCESS_BATCH_SIZE * 5 + 1);
+
+    ResetRequestCycles();
+}
+
+void TimedCache::PerformOperation(Operation const operation, address_t const address)
+{
+    MemoryAccess const access = {operation, address};
+    PerformOperations(&access, 1);
+}
+
+void TimedCache::PerformOperations(MemoryAccess const* accesses, std::size_t const count)
+{
+    // Issue the whole batch first, so that the cache keeps its prefetch pipeline.
+    m_first_position = m_cache->GetCycle();
+    m_request_cycles.clear();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Flush points do not advance the cache clock.
+        if (accesses[i].m_operation != FLUSH)
+            m_request_cycles.push_back(Issue(accesses[i].m_timestamp) + c_hit_latency);
+    }
+
+    // Flush points at the end of the batch.
+    m_request_cycles.push_back(GetNextCycle());
+    m_cache->PerformOperations(accesses, count);
+}
+
+void TimedCache::Flush()
+{
+    ResetRequestCycles();
+    m_cache->Flush();
+}
+
+void TimedCache::Writeback()
+{
+    ResetRequestCycles();
+    m_cache->Writeback();
+}
+
+void TimedCache::PrintConfiguration(std::ostream& stream) const
+{
+    static char const* const c_timing_names[] = {"access", "rate", "instruction gaps", "trace timestamps"};
+
+    m_cache->PrintConfiguration(stream);
+
+    stream << std::endl;
+    stream << "Timing:         " << std::endl;
+    stream << "    Issue:      " << c_timing_names[static_cast<int>(c_timing)];
+    if (c_timing != IssueTiming::TRACE)
+        stream << ", " << std::ldexp(1.0, c_fraction_bits) / c_access_period << " accesses/cycle";
+    if (c_timing == IssueTiming::INSTRUCTION_GAPS)
+        stream << ", " << std::ldexp(static_cast<double>(c_instruction_period), -static_cast<int>(c_fraction_bits)) << " cycles/instruction";
+    stream << std::endl;
+    stream << "    Latency:    " << c_hit_latency << " cycles" << std::endl;
+    stream << std::endl;
+}
+
+timestamp_t TimedCache::Issue(timestamp_t timestamp)
+{
+    switch (c_timing)
+    {
+        case IssueTiming::INSTRUCTION_GAPS:
+        {
+            // The core waits for the instructions in between, or for a free access slot.
+            std::uint64_t const gap = timestamp == TIMESTAMP_MAX ? 0 : timestamp * c_instruction_period;
+            m_time += std::max(c_access_period, gap);
+            return m_time >> c_fraction_bits;
+        }
+
+        case IssueTiming::TRACE:
+            // Accesses without a timestamp, and out-of-order ones, go with the previous access.
+            if (timestamp != TIMESTAMP_MAX && timestamp > m_trace_cycle)
+                m_trace_cycle = timestamp;
+
+            return m_trace_cycle;
+
+        default:
+            m_time += c_access_period;
+            return m_time >> c_fraction_bits;
+    }
+}
+
+timestamp_t TimedCache::GetNextCycle() const
+{
+    // The trace has the next timestamp, which is not read yet.
+    if (c_timing == IssueTiming::TRACE)
+        return m_trace_cycle + c_hit_latency;
+
+    return ((m_time + c_access_period) >> c_fraction_bits) + c_hit_latency;
+}
+
+void TimedCache::ResetRequestCycles()
+{
+    m_request_cycles.assign(1, GetNextCycle());
+    m_first_position = m_cache->GetCycle();
+}
@@ -0,0 +1,55 @@
+/**
+ * @file      translated_cache.cpp
+ * @brief     Translated cache class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <core/translated_cache.h>
+
+#include <iostream>
+
+TranslatedCache::TranslatedCache(Config const& config, std::unique_ptr<CacheModel> cache) :
+        c_prefetch_distance(config.m_prefetch_distance),
+        m_cache(std::move(cache)),
+        m_translator(config)
+{
+    // A TLB miss adds at most a 4-level walk.
+    m_translated.reserve(ACCESS_BATCH_SIZE * 5);
+}
+
+void TranslatedCache::PerformOperation(Operation const operation, address_t const address)
+{
+    m_translated.clear();
+    m_translator.Translate({operation, address}, m_translated);
+
+    for (MemoryAccess const& access : m_translated)
+        m_cache->PerformOperation(access.m_operation, access.m_address);
+}
+
+void TranslatedCache::PerformOperations(MemoryAccess const* accesses, std::size_t const count)
+{
+    // Page-table slots are prefetched prefetch_distance accesses ahead, so that TLB misses overlap.
+    m_translated.clear();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (c_prefetch_distance != 0 && i + c_prefetch_distance < count)
+            m_translator.Prefetch(accesses[i + c_prefetch_distance].m_address);
+
+        m_translator.Translate(accesses[i], m_translated);
+    }
+
+    m_cache->PerformOperations(m_translated.data(), m_translated.size());
+}
+
+void TranslatedCache::PrintConfiguration(std::ostream& stream) const
+{
+    m_cache->PrintConfiguration(stream);
+    m_translator.PrintConfiguration(stream);
+}
@@ -14,13 +14,23 @@
 #include <stdint.h>
 #include <stdio.h>
 
-#include <core/cache.h>
+#include <core/cache_model.h>
+#include <utils/batch_runner.h>
 #include <utils/config_reader.h>
+#include <utils/dram_analyzer.h>
+#include <utils/pipeline_runner.h>
 #include <utils/program_options.h>
+#include <utils/result_store.h>
+#include <utils/shm_trace_reader.h>
+#include <utils/simulation.h>
+#include <utils/slice_runner.h>
+#include <utils/sweep_runner.h>
 #include <utils/trace_reader.h>
 #include <utils/trace_engine.h>
 
+#include <chrono>
 #include <filesystem>
+#include <vector>
 
 int main(int argc, char* argv[])
 {
@@ -31,30 +41,223 @@ int main(int argc, char* argv[])
     if (program_options.m_should_exit)
         return 0;
 
+    if (program_options.m_sweep_step == SweepStep::PLAN)
+    {
+        // Sweep mode: expand the grid into jobs for the workers.
+        std::cout << "Loading configuration from: " << program_options.m_config_file << "..." << std::endl;
+        std::size_t const jobs = SweepRunner::Plan(program_options.m_config_file, program_options.m_sweep_directory);
+
+        std::cout << "Planned " << jobs << " jobs in " << program_options.m_sweep_directory << "." << std::endl;
+        return 0;
+    }
+
+    if (program_options.m_sweep_step == SweepStep::WORK)
+    {
+        // Run the jobs no other worker has claimed.
+        SweepRunner sweep_runner(program_options.m_sweep_directory, program_options.m_batch_threads, program_options.m_pin_threads, program_options.m_result_store);
+
+        std::cout << "Working on the sweep in " << program_options.m_sweep_directory << "..." << std::endl;
+        std::size_t const jobs = sweep_runner.Work();
+
+        std::cout << "Ran " << jobs << " jobs; no unclaimed job is left." << std::endl;
+        return 0;
+    }
+
+    if (program_options.m_sweep_step == SweepStep::MERGE)
+    {
+        std::string report_file = program_options.m_batch_report_file;
+        if (report_file.empty())
+            report_file = (std::filesystem::path(program_options.m_sweep_directory) / "results.csv").string();
+
+        SweepSummary const summary = SweepRunner::Merge(program_options.m_sweep_directory, report_file, std::cout);
+        std::cout << "    Report:          " << report_file << std::endl;
+
+        // Fail if any job failed.
+        return summary.m_failed != 0 ? 1 : 0;
+    }
+
     std::cout << "Loading configuration from: " << program_options.m_config_file << "..." << std::endl;
 
+    if (!program_options.m_batch_inputs.empty())
+    {
+        // Batch mode: many traces, one independent cache and output each.
+        Config const config = ConfigReader::Load(program_options.m_config_file, /* Require IO */ false);
+        std::vector<std::string> const inputs = BatchRunner::ExpandInputs(program_options.m_batch_inputs);
+
+        BatchRunner batch_runner(config, program_options.m_batch_output_directory, program_options.m_batch_threads, program_options.m_pin_threads, program_options.m_result_store);
+
+        std::cout << "Simulating " << inputs.size() << " traces with a " << config.m_sets << "x" << config.m_ways << "x" << config.m_line_size
+                  << " cache into " << program_options.m_batch_output_directory << "..." << std::endl;
+
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<BatchResult> const results = batch_runner.Run(inputs);
+        double const wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string report_file = program_options.m_batch_report_file;
+        if (report_file.empty())
+            report_file = (std::filesystem::path(program_options.m_batch_output_directory) / "batch_report.csv").string();
+
+        BatchRunner::WriteReportCsv(report_file, results);
+        batch_runner.PrintReport(std::cout, results, wall_seconds);
+        std::cout << "    Report:          " << report_file << std::endl;
+
+        // Fail if any job failed.
+        for (BatchResult const& result : results)
+            if (!result.m_error.empty())
+                return 1;
+
+        return 0;
+    }
+
     // Load configuration.
-    ConfigReader::Load(program_options.m_config_file);
-    ConfigReader::PrintConfig();
-    Config config = ConfigReader::GetConfig();
+    Config config = ConfigReader::Load(program_options.m_config_file);
+    ConfigReader::PrintConfig(config);
+
+    if (program_options.m_slices != 0)
+    {
+        // Time-sliced mode: approximate, the slices of the trace run in parallel.
+        SliceRunner slice_runner(config, program_options.m_slices, program_options.m_slice_warmup, program_options.m_batch_threads, program_options.m_pin_threads);
+
+        std::cout << "Simulating " << program_options.m_slices << " time slices with " << program_options.m_slice_warmup << " warmup accesses each..." << std::endl;
+
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<SliceResult> results = slice_runner.Run();
+        double const wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (program_options.m_verify_slices)
+        {
+            std::cout << "Running the exact simulation to verify the slices..." << std::endl;
+            slice_runner.Verify(results);
+        }
+
+        slice_runner.PrintReport(std::cout, results, wall_seconds, program_options.m_verify_slices);
+        return 0;
+    }
+
+    std::unique_ptr<ResultStore> store;
+    std::string fingerprint;
+    RunStats stats;
+
+    if (!program_options.m_result_store.empty())
+    {
+        if (!config.m_input_shm_name.empty())
+            throw std::invalid_argument("A live input cannot be fingerprinted; the --result-store option needs an input trace file.");
+
+        // Reuse the output of an identical run if there is one.
+        store = std::make_unique<ResultStore>(program_options.m_result_store);
+        fingerprint = ResultStore::Fingerprint(config.m_input_trace_file, config);
+
+        // The DRAM analysis is not stored: it needs the requests.
+        if (!config.m_dram_analyzer && store->Fetch(fingerprint, config.m_output_trace_file, stats))
+        {
+            std::cout << "Reusing stored result " << store->GetEntryPath(fingerprint) << " (simulated in " << stats.m_seconds << " s)" << std::endl;
+            std::cout << "    Accesses:        " << stats.m_loads + stats.m_stores << std::endl;
+            std::cout << "    DRAM reads:      " << stats.m_dram_reads << std::endl;
+            std::cout << "    DRAM writes:     " << stats.m_dram_writes << std::endl;
+            return 0;
+        }
+    }
+
+    auto const start = std::chrono::steady_clock::now();
 
     // Initialize the output Trace Engine.
-    TraceEngine::Initialize(config.m_output_trace_file);
+    TraceEngine trace_engine(config.m_output_trace_file, /* Quiet */ false, config.m_output_trace_format);
+
+    // Write-combining buffer and DRAM analyzer in front of the Trace Engine, if enabled.
+    SinkChain sink_chain(config, trace_engine, /* Analyze */ true);
+    MemorySink& sink = sink_chain.GetSink();
 
-    // Initialize the input trace reader.
-    TraceReader trace_reader(config.m_input_trace_file);
+    // In pipelined runs the cache sends its requests to the writer thread.
+    std::unique_ptr<PipelineRunner> pipeline;
+    if (program_options.m_pipeline)
+        pipeline = std::make_unique<PipelineRunner>(program_options.m_pin_threads);
+
+    // During the functional warmup, the requests of the cache are dropped.
+    MemorySink& cache_sink = pipeline ? pipeline->GetCacheSink() : sink;
+    std::unique_ptr<GatedSink> warmup_gate;
+    if (config.m_warmup_accesses != 0)
+        warmup_gate = std::make_unique<GatedSink>(cache_sink);
 
     // Initialize the cache.
-    Cache cache(/* Sets */ config.m_sets, /* Ways */ config.m_ways, /* Line size */ config.m_line_size);
+    std::unique_ptr<CacheModel> cache = CreateCacheModel(config, warmup_gate ? *warmup_gate : cache_sink);
+    cache->PrintConfiguration(std::cout);
+
+    // Initialize the input: a live tracer or a trace file.
+    std::unique_ptr<ShmTraceReader> shm_reader;
+    std::unique_ptr<TraceReader> trace_reader;
+    PipelineRunner::Source source;
+
+    if (!config.m_input_shm_name.empty())
+    {
+        // Simulate concurrently with a live tracer.
+        shm_reader = std::make_unique<ShmTraceReader>(config.m_input_shm_name, config.m_input_shm_lanes, config.m_input_shm_capacity, config.m_input_shm_wait);
+        source = [&](MemoryAccess* accesses, std::size_t max_count) { return shm_reader->GetNextAccesses(accesses, max_count); };
+    }
+    else
+    {
+        trace_reader = std::make_unique<TraceReader>(config.m_input_trace_file);
+        source = [&](MemoryAccess* accesses, std::size_t max_count) { return trace_reader->GetNextAccesses(accesses, max_count); };
+
+        // Skip, filter and warm up as the [REGION] section says.
+        EnterRegion(config, *trace_reader, *cache, warmup_gate.get(), /* Quiet */ false);
+    }
+
+    if (pipeline)
+    {
+        // Reader, cache and writer on their own threads. The cache is flushed by its thread.
+        PipelineStats const pipeline_stats = pipeline->Run(source, *cache, sink);
+        PipelineRunner::PrintReport(std::cout, pipeline_stats);
+
+        stats.m_loads = pipeline_stats.m_loads;
+        stats.m_stores = pipeline_stats.m_stores;
+    }
+    else
+    {
+        // Accesses are handed to the cache in batches.
+        std::vector<MemoryAccess> batch(ACCESS_BATCH_SIZE);
+        std::size_t count;
+
+        while ((count = source(batch.data(), batch.size())) != 0)
+        {
+            // The accesses are only counted for the result store.
+            for (std::size_t i = 0; store && i < count; ++i)
+            {
+                if (batch[i].m_operation == STORE)
+                    ++stats.m_stores;
+                else if (batch[i].m_operation == LOAD)
+                    ++stats.m_loads;
+            }
+
+            cache->PerformOperations(batch.data(), count);
+        }
+
+        cache->Flush();
+    }
+
+    // Requests still held by the write-combining buffer go to memory last.
+    sink_chain.Drain();
+    if (sink_chain.GetWriteCombining())
+        sink_chain.GetWriteCombining()->PrintStatistics(std::cout);
+
+    cache->PrintStatistics(std::cout);
+
+    if (trace_reader && (!config.m_include_ranges.empty() || !config.m_exclude_ranges.empty()))
+        std::cout << "Filtered out " << trace_reader->GetFilteredCount() << " accesses by address." << std::endl;
 
-    Operation op_type;
-    address_t address;
+    if (sink_chain.GetAnalyzer())
+        sink_chain.GetAnalyzer()->PrintReport(std::cout);
 
-    while (trace_reader.GetNextAccess(op_type, address))
-        cache.PerformOperation(op_type, address);
+    stats.m_dram_reads = trace_engine.GetRequestCount(LOAD);
+    stats.m_dram_writes = trace_engine.GetRequestCount(STORE);
+    trace_engine.Shutdown();
 
-    cache.Flush();
-    TraceEngine::Shutdown();
+    if (store)
+    {
+        // Publish the result for identical runs.
+        stats.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        store->Store(fingerprint, config.m_output_trace_file, stats);
+        std::cout << "Stored result " << store->GetEntryPath(fingerprint) << std::endl;
+    }
 
     return 0;
 }
@@ -0,0 +1,324 @@
+/**
+ * @file      batch_runner.cpp
+ * @brief     Batch runner class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/batch_runner.h>
+
+#include <core/cache_model.h>
+#include <utils/result_store.h>
+#include <utils/simulation.h>
+#include <utils/thread_pool.h>
+#include <utils/threading.h>
+#include <utils/trace_engine.h>
+#include <utils/trace_format.h>
+#include <utils/trace_reader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+#include <glob.h>
+
+namespace
+{
+    // Whether a file holds a trace rather than a manifest: a binary signature, or a first record whose
+    // operation is known. Manifest lines are paths.
+    bool IsTraceFile(std::string const& file)
+    {
+        std::ifstream stream(file, std::ios::binary);
+
+        trace_format::Header header{};
+        if (stream.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.m_magic == trace_format::c_magic)
+            return true;
+
+        stream.clear();
+        stream.seekg(0);
+
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            std::size_t const first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos)
+                continue;
+
+            std::string const operation = line.substr(first, line.find_first_of(" \t\r", first) - first);
+            return operation == "LD" || operation == "ST" || operation == "FLUSH" || operation == "ROI_BEGIN" || operation == "ROI_END";
+        }
+
+        return false;
+    }
+}
+
+BatchRunner::BatchRunner(Config const& config, std::string const& output_directory, unsigned threads, bool pin_threads, std::string const& result_store)
+    : c_config(config), c_output_directory(output_directory), c_thread_count(ResolveThreadCount(threads)), c_pin_threads(pin_threads), c_result_store(result_store)
+{
+}
+
+std::vector<std::string> BatchRunner::ExpandInputs(std::string const& inputs)
+{
+    std::vector<std::string> files;
+
+    if (std::filesystem::is_directory(inputs))
+    {
+        // Every trace in the directory.
+        for (auto const& entry : std::filesystem::directory_iterator(inputs))
+            if (entry.is_regular_file() && entry.path().extension() == ".trace")
+                files.push_back(entry.path().string());
+
+        std::sort(files.begin(), files.end());
+    }
+    else if (inputs.find_first_of("*?[") != std::string::npos)
+    {
+        // Glob pattern. Matches are returned sorted.
+        glob_t matches;
+        int const status = glob(inputs.c_str(), 0, nullptr, &matches);
+
+        if (status != 0 && status != GLOB_NOMATCH)
+            throw std::runtime_error("Error: Could not expand pattern " + inputs);
+
+        for (std::size_t i = 0; status == 0 && i < matches.gl_pathc; ++i)
+            files.push_back(matches.gl_pathv[i]);
+
+        globfree(&matches);
+    }
+    else if (IsTraceFile(inputs))
+    {
+        // A single trace.
+        files.push_back(inputs);
+    }
+    else
+    {
+        // Manifest: one trace per line. Relative paths are relative to the manifest.
+        std::ifstream manifest(inputs);
+        if (!manifest.is_open())
+            throw std::invalid_argument("Batch input not found: " + inputs);
+
+        std::filesystem::path const base = std::filesystem::path(inputs).parent_path();
+        std::string line;
+
+        while (std::getline(manifest, line))
+        {
+            // Trim whitespace and skip blank lines and comments.
+            std::size_t const first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+
+            std::size_t const last = line.find_last_not_of(" \t\r");
+            std::filesystem::path const path = line.substr(first, last - first + 1);
+
+            files.push_back((path.is_relative() ? base / path : path).string());
+        }
+    }
+
+    if (files.empty())
+        throw std::invalid_argument("No input traces found in " + inputs);
+
+    return files;
+}
+
+std::vector<BatchResult> BatchRunner::Run(std::vector<std::string> const& input_files)
+{
+    std::filesystem::create_directories(c_output_directory);
+
+    std::vector<BatchResult> results(input_files.size());
+    std::set<std::string> outputs;
+
+    for (std::size_t i = 0; i < input_files.size(); ++i)
+    {
+        BatchResult& result = results[i];
+        result.m_input_file = input_files[i];
+
+        // Name the output after the input: <output directory>/<stem>.out.trace.
+        std::filesystem::path const input(result.m_input_file);
+        result.m_output_file = (std::filesystem::path(c_output_directory) / (input.stem().string() + ".out.trace")).string();
+
+        if (!outputs.insert(result.m_output_file).second)
+            throw std::invalid_argument("Two batch inputs share the name " + input.stem().string() + "; their outputs would collide.");
+
+        std::error_code error;
+        std::uintmax_t const size = std::filesystem::file_size(input, error);
+        result.m_input_bytes = error ? 0 : size;
+    }
+
+    // Longest processing time first: the run time of a job is roughly proportional to the trace size.
+    std::vector<std::size_t> order(results.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return results[a].m_input_bytes > results[b].m_input_bytes; });
+
+    std::unique_ptr<ResultStore> const store = c_result_store.empty() ? nullptr : std::make_unique<ResultStore>(c_result_store);
+
+    std::mutex progress_mutex;
+    std::size_t completed = 0;
+    std::vector<ThreadPool::Task> tasks;
+
+    for (std::size_t const index : order)
+    {
+        tasks.push_back([&, index](unsigned worker)
+        {
+            BatchResult& result = results[index];
+            result.m_worker = worker;
+            RunJob(c_config, result, store.get());
+
+            // Report progress.
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            std::cout << "[" << std::setw(std::to_string(results.size()).size()) << ++completed << "/" << results.size() << "] "
+                      << result.m_input_file << (result.m_error.empty() ? (result.m_reused ? " (stored)" : "") : " FAILED: " + result.m_error)
+                      << " (" << std::fixed << std::setprecision(2) << result.m_seconds << " s)" << std::defaultfloat << std::endl;
+        });
+    }
+
+    ThreadPool pool(c_thread_count, c_pin_threads);
+    pool.Run(std::move(tasks));
+
+    return results;
+}
+
+void BatchRunner::RunJob(Config const& config, BatchResult& result, ResultStore const* store)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    try
+    {
+        std::string const fingerprint = store ? ResultStore::Fingerprint(result.m_input_file, config) : "";
+        RunStats stats;
+
+        if (store && store->Fetch(fingerprint, result.m_output_file, stats))
+        {
+            result.m_loads = stats.m_loads;
+            result.m_stores = stats.m_stores;
+            result.m_dram_reads = stats.m_dram_reads;
+            result.m_dram_writes = stats.m_dram_writes;
+            result.m_reused = true;
+            result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return;
+        }
+
+        // Every job owns its output, reader and cache. The requests take the same path as in a single run.
+        TraceEngine trace_engine(result.m_output_file, /* Quiet */ true, config.m_output_trace_format);
+        SinkChain sink_chain(config, trace_engine, /* Analyze */ false);
+
+        // During the functional warmup, the requests of the cache are dropped.
+        std::unique_ptr<GatedSink> warmup_gate;
+        if (config.m_warmup_accesses != 0)
+            warmup_gate = std::make_unique<GatedSink>(sink_chain.GetSink());
+
+        std::unique_ptr<CacheModel> cache = CreateCacheModel(config, warmup_gate ? *warmup_gate : sink_chain.GetSink());
+
+        // Skip, filter and warm up as the [REGION] section says.
+        TraceReader trace_reader(result.m_input_file);
+        EnterRegion(config, trace_reader, *cache, warmup_gate.get(), /* Quiet */ true);
+
+        std::vector<MemoryAccess> batch(ACCESS_BATCH_SIZE);
+        std::size_t count;
+
+        while ((count = trace_reader.GetNextAccesses(batch.data(), batch.size())) != 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (batch[i].m_operation == STORE)
+                    ++result.m_stores;
+                else if (batch[i].m_operation == LOAD)
+                    ++result.m_loads;
+            }
+
+            cache->PerformOperations(batch.data(), count);
+        }
+
+        cache->Flush();
+        sink_chain.Drain();
+
+        result.m_dram_reads = trace_engine.GetRequestCount(LOAD);
+        result.m_dram_writes = trace_engine.GetRequestCount(STORE);
+        trace_engine.Shutdown();
+
+        if (store)
+        {
+            stats = {result.m_loads, result.m_stores, result.m_dram_reads, result.m_dram_writes,
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+            store->Store(fingerprint, result.m_output_file, stats);
+        }
+    }
+    catch (std::exception const& exception)
+    {
+        result.m_error = exception.what();
+    }
+
+    result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void BatchRunner::PrintReport(std::ostream& stream, std::vector<BatchResult> const& results, double wall_seconds) const
+{
+    std::ios::fmtflags const flags = stream.flags();
+
+    std::uint64_t accesses = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t dram_requests = 0;
+    std::size_t failures = 0;
+    std::size_t reused = 0;
+    double job_seconds = 0;
+
+    for (BatchResult const& result : results)
+    {
+        accesses += result.m_loads + result.m_stores;
+        bytes += result.m_input_bytes;
+        dram_requests += result.m_dram_reads + result.m_dram_writes;
+        failures += !result.m_error.empty();
+        reused += result.m_reused;
+        job_seconds += result.m_seconds;
+    }
+
+    // Fraction of the workers' time spent simulating.
+    double const utilization = wall_seconds > 0 ? job_seconds / (wall_seconds * c_thread_count) : 0;
+
+    stream << std::endl;
+    stream << "Batch Summary:" << std::endl;
+    stream << "    Jobs:            " << results.size() << " (" << failures << " failed" << (c_result_store.empty() ? "" : ", " + std::to_string(reused) + " reused from the result store") << ")" << std::endl;
+    stream << "    Workers:         " << c_thread_count << (c_pin_threads ? " (pinned)" : "") << std::endl;
+    stream << "    Accesses:        " << accesses << std::endl;
+    stream << "    DRAM requests:   " << dram_requests << std::endl;
+    stream << std::fixed << std::setprecision(2);
+    stream << "    Wall time:       " << wall_seconds << " s" << std::endl;
+    stream << "    Throughput:      " << (wall_seconds > 0 ? accesses / wall_seconds / 1e6 : 0.0) << " M accesses/s, "
+           << (wall_seconds > 0 ? bytes / wall_seconds / 1e6 : 0.0) << " MB/s" << std::endl;
+    stream << "    Utilization:     " << utilization * 100 << " %" << std::endl;
+
+    for (BatchResult const& result : results)
+        if (!result.m_error.empty())
+            stream << "    FAILED:          " << result.m_input_file << ": " << result.m_error << std::endl;
+
+    stream.flags(flags);
+}
+
+void BatchRunner::WriteReportCsv(std::string const& report_file, std::vector<BatchResult> const& results)
+{
+    std::ofstream report(report_file, std::ios::trunc);
+    if (!report.is_open())
+        throw std::runtime_error("Could not write to output file " + report_file);
+
+    report << "input,output,input_bytes,loads,stores,dram_reads,dram_writes,miss_rate,seconds,worker,status" << std::endl;
+
+    for (BatchResult const& result : results)
+    {
+        std::uint64_t const accesses = result.m_loads + result.m_stores;
+
+        report << result.m_input_file << ',' << result.m_output_file << ',' << result.m_input_bytes << ','
+               << result.m_loads << ',' << result.m_stores << ',' << result.m_dram_reads << ',' << result.m_dram_writes << ','
+               << (accesses ? static_cast<double>(result.m_dram_reads) / accesses : 0.0) << ',' << result.m_seconds << ','
+               << result.m_worker << ',' << (!result.m_error.empty() ? "failed" : result.m_reused ? "reused" : "ok") << std::endl;
+    }
+}
@@ -17,81 +17,520 @@
 #include <tomlplusplus/include/toml++/toml.h>
 
 #include <filesystem>
+#include <initializer_list>
 #include <iostream>
+#include <optional>
+#include <vector>
 
-// Define the static config member.
-Config ConfigReader::m_config;
+namespace
+{
+    // Parse a write policy name.
+    WritePolicy ParseWritePolicy(std::string const& name)
+    {
+        if (name == "write_back")
+            return WritePolicy::WRITE_BACK;
+
+        if (name == "write_through")
+            return WritePolicy::WRITE_THROUGH;
+
+        throw std::runtime_error("Invalid configuration: write_policy must be \"write_back\" or \"write_through\".");
+    }
+
+    // Load a swept key: a value or a non-empty list of values of the same type. Empty if the key is absent.
+    template <typename T, typename NodeView>
+    std::vector<T> LoadList(NodeView const& node, std::string const& key)
+    {
+        std::vector<T> values;
+        if (!node)
+            return values;
+
+        if (auto* const array = node.as_array())
+        {
+            for (std::size_t i = 0; i < array->size(); ++i)
+            {
+                std::optional<T> const value = (*array)[i].template value<T>();
+                if (!value)
+                    throw std::runtime_error("Invalid configuration: [SWEEP] " + key + " mixes values of different types.");
+
+                values.push_back(*value);
+            }
+        }
+        else if (std::optional<T> const value = node.template value<T>())
+        {
+            values.push_back(*value);
+        }
+
+        if (values.empty())
+            throw std::runtime_error("Invalid configuration: [SWEEP] " + key + " must be a value or a non-empty list of values.");
+
+        return values;
+    }
+
+    // Replace every point of a grid by one copy per value of a new key.
+    template <typename T, typename Apply>
+    void ExpandGrid(std::vector<Config>& points, std::vector<T> const& values, Apply apply)
+    {
+        if (values.empty())
+            return;
+
+        std::vector<Config> expanded;
+        expanded.reserve(points.size() * values.size());
+
+        for (Config const& point : points)
+        {
+            for (T const& value : values)
+            {
+                expanded.push_back(point);
+                apply(expanded.back(), value);
+            }
+        }
+
+        points = std::move(expanded);
+    }
+
+    // Positive integer setting, 0 if it is not.
+    std::size_t ToSize(std::int64_t value)
+    {
+        return value > 0 ? static_cast<std::size_t>(value) : 0;
+    }
+
+    // Load a list of address ranges, given as [begin, end] pairs of integers.
+    template <typename NodeView>
+    std::vector<AddressRange> LoadRanges(NodeView const& node, std::string const& key)
+    {
+        std::vector<AddressRange> ranges;
+        if (!node)
+            return ranges;
+
+        auto* const array = node.as_array();
+        bool valid = array != nullptr;
+
+        for (std::size_t i = 0; valid && i < array->size(); ++i)
+        {
+            auto* const pair = (*array)[i].as_array();
+            std::optional<std::int64_t> const begin = pair && pair->size() == 2 ? (*pair)[0].template value<std::int64_t>() : std::nullopt;
+            std::optional<std::int64_t> const end = pair && pair->size() == 2 ? (*pair)[1].template value<std::int64_t>() : std::nullopt;
+
+            valid = begin && end && *begin >= 0 && *begin < *end;
+            if (valid)
+                ranges.push_back({static_cast<address_t>(*begin), static_cast<address_t>(*end)});
+        }
+
+        if (!valid)
+            throw std::runtime_error("Invalid configuration: " + key + " must be a list of [begin, end] address pairs, with begin < end.");
+
+        return ranges;
+    }
+}
 
-void ConfigReader::Load(std::string const& config_file)
+Config ConfigReader::Load(std::string const& config_file, bool require_io)
 {
     auto config_data = toml::parse_file(config_file);
+    Config config;
 
     // Load the cache parameters.
-    m_config.m_sets      = config_data["CACHE"]["sets"].value_or(0);
-    m_config.m_ways      = config_data["CACHE"]["ways"].value_or(0);
-    m_config.m_line_size = config_data["CACHE"]["line_size"].value_or(0);
+    config.m_sets      = config_data["CACHE"]["sets"].value_or(0);
+    config.m_ways      = config_data["CACHE"]["ways"].value_or(0);
+    config.m_line_size = config_data["CACHE"]["line_size"].value_or(0);
+
+    // Load the cache organization.
+    std::string const organization = config_data["CACHE"]["organization"].value_or("set_associative");
+    if (organization == "set_associative")
+        config.m_organization = CacheOrganization::SET_ASSOCIATIVE;
+    else if (organization == "sectored")
+        config.m_organization = CacheOrganization::SECTORED;
+    else
+        throw std::runtime_error("Invalid configuration: organization must be \"set_associative\" or \"sectored\".");
+
+    config.m_sector_size  = config_data["CACHE"]["sector_size"].value_or(64);
+    config.m_address_bits = config_data["CACHE"]["address_bits"].value_or(48);
+
+    // Load the prefetch distance of the access pipeline.
+    config.m_prefetch_distance = config_data["CACHE"]["prefetch_distance"].value_or(DEFAULT_PREFETCH_DISTANCE);
+    config.m_huge_pages        = config_data["CACHE"]["huge_pages"].value_or(true);
+
+    // Load the flush points.
+    config.m_flush_interval = config_data["CACHE"]["flush_interval"].value_or(0);
+
+    std::string const flush_mode = config_data["CACHE"]["flush_mode"].value_or("invalidate");
+    if (flush_mode == "invalidate")
+        config.m_flush_mode = FlushMode::INVALIDATE;
+    else if (flush_mode == "writeback")
+        config.m_flush_mode = FlushMode::WRITEBACK;
+    else
+        throw std::runtime_error("Invalid configuration: flush_mode must be \"invalidate\" or \"writeback\".");
+
+    // Load the write policy.
+    config.m_write_policy = ParseWritePolicy(config_data["CACHE"]["write_policy"].value_or("write_back"));
+
+    config.m_write_allocate   = config_data["CACHE"]["write_allocate"].value_or(true);
+    config.m_streaming_stores = config_data["CACHE"]["streaming_stores"].value_or(false);
+
+    // Load the write-combining buffer.
+    config.m_write_combining         = config_data["WRITE_COMBINING"]["enabled"].value_or(false);
+    config.m_write_combining_entries = config_data["WRITE_COMBINING"]["entries"].value_or(16);
+
+    // Load the address translation.
+    config.m_translation      = config_data["TRANSLATION"]["enabled"].value_or(false);
+    config.m_page_size        = config_data["TRANSLATION"]["page_size"].value_or(4096);
+    config.m_physical_memory  = config_data["TRANSLATION"]["physical_memory_gb"].value_or(64);
+    config.m_physical_memory <<= 30;
+    config.m_numa_nodes       = config_data["TRANSLATION"]["numa_nodes"].value_or(1);
+    config.m_translation_seed = config_data["TRANSLATION"]["seed"].value_or(1);
+    config.m_tlb_entries      = config_data["TRANSLATION"]["tlb_entries"].value_or(64);
+    config.m_page_walks       = config_data["TRANSLATION"]["page_walks"].value_or(false);
+
+    std::string const allocation = config_data["TRANSLATION"]["allocation"].value_or("sequential");
+    if (allocation == "sequential")
+        config.m_page_allocation = PageAllocation::SEQUENTIAL;
+    else if (allocation == "random")
+        config.m_page_allocation = PageAllocation::RANDOM;
+    else if (allocation == "numa")
+        config.m_page_allocation = PageAllocation::NUMA;
+    else
+        throw std::runtime_error("Invalid configuration: allocation must be \"sequential\", \"random\" or \"numa\".");
+
+    // Load the DRAM analyzer.
+    config.m_dram_analyzer    = config_data["DRAM"]["enabled"].value_or(false);
+    config.m_dram_channels    = config_data["DRAM"]["channels"].value_or(1);
+    config.m_dram_ranks       = config_data["DRAM"]["ranks"].value_or(1);
+    config.m_dram_bank_groups = config_data["DRAM"]["bank_groups"].value_or(4);
+    config.m_dram_banks       = config_data["DRAM"]["banks"].value_or(4);
+    config.m_dram_rows        = config_data["DRAM"]["rows"].value_or(65536);
+    config.m_dram_row_size    = config_data["DRAM"]["row_size"].value_or(8192);
+    config.m_dram_mapping     = config_data["DRAM"]["mapping"].value_or("RoRaBgBaCoCh");
+    config.m_dram_xor_banks   = config_data["DRAM"]["xor_banks"].value_or(false);
+    config.m_dram_window      = config_data["DRAM"]["window"].value_or(64);
+
+    std::string const page_policy = config_data["DRAM"]["page_policy"].value_or("open");
+    if (page_policy == "open")
+        config.m_dram_page_policy = DramPagePolicy::OPEN;
+    else if (page_policy == "closed")
+        config.m_dram_page_policy = DramPagePolicy::CLOSED;
+    else
+        throw std::runtime_error("Invalid configuration: page_policy must be \"open\" or \"closed\".");
+
+    // Load the issue timing.
+    std::string const timing = config_data["TIMING"]["mode"].value_or("access");
+    if (timing == "access")
+        config.m_issue_timing = IssueTiming::ACCESS;
+    else if (timing == "rate")
+        config.m_issue_timing = IssueTiming::RATE;
+    else if (timing == "instruction_gaps")
+        config.m_issue_timing = IssueTiming::INSTRUCTION_GAPS;
+    else if (timing == "trace")
+        config.m_issue_timing = IssueTiming::TRACE;
+    else
+        throw std::runtime_error("Invalid configuration: TIMING mode must be \"access\", \"rate\", \"instruction_gaps\" or \"trace\".");
+
+    config.m_accesses_per_cycle     = config_data["TIMING"]["accesses_per_cycle"].value_or(1.0);
+    config.m_cycles_per_instruction = config_data["TIMING"]["cycles_per_instruction"].value_or(1.0);
+    config.m_hit_latency            = config_data["TIMING"]["hit_latency"].value_or(0);
+
+    // Load the simulated region of the input trace.
+    config.m_roi              = config_data["REGION"]["roi"].value_or(false);
+    config.m_skip_accesses    = config_data["REGION"]["skip"].value_or(0);
+    config.m_warmup_accesses  = config_data["REGION"]["warmup"].value_or(0);
+    config.m_measure_accesses = config_data["REGION"]["measure"].value_or(0);
+    config.m_include_ranges   = LoadRanges(config_data["REGION"]["include"], "include");
+    config.m_exclude_ranges   = LoadRanges(config_data["REGION"]["exclude"], "exclude");
 
     // Load the input and output trace file paths.
-    m_config.m_input_trace_file  = config_data["IO"]["input_trace_file"].value_or("");
-    m_config.m_output_trace_file = config_data["IO"]["output_trace_file"].value_or("");
+    config.m_input_trace_file  = config_data["IO"]["input_trace_file"].value_or("");
+    config.m_output_trace_file = config_data["IO"]["output_trace_file"].value_or("");
 
-    ValidateConfig();
+    std::string const output_format = config_data["IO"]["output_trace_format"].value_or("text");
+    try
+    {
+        config.m_output_trace_format = trace_format::Parse(output_format);
+    }
+    catch (std::invalid_argument const&)
+    {
+        throw std::runtime_error("Invalid configuration: output_trace_format must be \"text\", \"timed\", \"binary\", \"dramsim3\" or \"dramsys\".");
+    }
+
+    // Load the shared-memory input, if any.
+    config.m_input_shm_name     = config_data["IO"]["input_shm_name"].value_or("");
+    config.m_input_shm_lanes    = config_data["IO"]["input_shm_lanes"].value_or(1);
+    config.m_input_shm_capacity = config_data["IO"]["input_shm_capacity"].value_or(1 << 20);
+
+    std::string const wait_policy = config_data["IO"]["input_shm_wait"].value_or("block");
+    if (wait_policy == "spin")
+        config.m_input_shm_wait = WaitPolicy::SPIN;
+    else if (wait_policy == "block")
+        config.m_input_shm_wait = WaitPolicy::BLOCK;
+    else
+        throw std::runtime_error("Invalid configuration: input_shm_wait must be \"spin\" or \"block\".");
+
+    ValidateConfig(config, require_io);
+    return config;
 }
 
-void ConfigReader::PrintConfig()
+void ConfigReader::PrintConfig(Config const& config)
 {
     std::cout << "Loaded Configuration:" << std::endl;
     std::cout << std::endl;
     std::cout << "Cache:" << std::endl;
-    std::cout << "  Sets: " << m_config.m_sets << std::endl;
-    std::cout << "  Ways: " << m_config.m_ways << std::endl;
-    std::cout << "  Line Size: " << m_config.m_line_size << " bytes" << std::endl;
+    std::cout << "  Sets: " << config.m_sets << std::endl;
+    std::cout << "  Ways: " << config.m_ways << std::endl;
+    std::cout << "  Line Size: " << config.m_line_size << " bytes" << std::endl;
+    if (config.m_organization == CacheOrganization::SECTORED)
+    {
+        std::cout << "  Organization: sectored" << std::endl;
+        std::cout << "  Sector Size: " << config.m_sector_size << " bytes" << std::endl;
+        std::cout << "  Address Bits: " << config.m_address_bits << std::endl;
+    }
+    if (config.m_flush_interval != 0)
+        std::cout << "  Flush Interval: " << config.m_flush_interval << " accesses ("
+                  << (config.m_flush_mode == FlushMode::WRITEBACK ? "writeback" : "invalidate") << ")" << std::endl;
+    if (config.m_streaming_stores)
+        std::cout << "  Stores: streaming" << std::endl;
+    else if (config.m_write_policy != WritePolicy::WRITE_BACK || !config.m_write_allocate)
+        std::cout << "  Stores: " << (config.m_write_policy == WritePolicy::WRITE_THROUGH ? "write-through" : "write-back")
+                  << (config.m_write_allocate ? ", write-allocate" : ", no-write-allocate") << std::endl;
+    if (config.m_write_combining)
+        std::cout << "  Write-Combining Buffer: " << config.m_write_combining_entries << " entries" << std::endl;
+    if (config.m_translation)
+    {
+        static char const* const c_allocation_names[] = {"sequential", "random", "numa"};
+
+        std::cout << std::endl;
+        std::cout << "Address Translation:" << std::endl;
+        std::cout << "  Page Size: " << config.m_page_size << " bytes" << std::endl;
+        std::cout << "  Allocation: " << c_allocation_names[static_cast<int>(config.m_page_allocation)];
+        if (config.m_page_allocation == PageAllocation::NUMA)
+            std::cout << " (" << config.m_numa_nodes << " nodes)";
+        std::cout << std::endl;
+        std::cout << "  Physical Memory: " << (config.m_physical_memory >> 30) << " GiB" << std::endl;
+        std::cout << "  TLB Entries: " << config.m_tlb_entries << std::endl;
+        std::cout << "  Page Walks: " << (config.m_page_walks ? "yes" : "no") << std::endl;
+    }
+    if (config.m_dram_analyzer)
+    {
+        std::cout << std::endl;
+        std::cout << "DRAM Analyzer:" << std::endl;
+        std::cout << "  Organization: " << config.m_dram_channels << " channels, " << config.m_dram_ranks << " ranks, "
+                  << config.m_dram_bank_groups << " bank groups, " << config.m_dram_banks << " banks" << std::endl;
+        std::cout << "  Rows: " << config.m_dram_rows << " of " << config.m_dram_row_size << " bytes" << std::endl;
+        std::cout << "  Mapping: " << config.m_dram_mapping << (config.m_dram_xor_banks ? " (bank XOR)" : "") << std::endl;
+        std::cout << "  Page Policy: " << (config.m_dram_page_policy == DramPagePolicy::OPEN ? "open" : "closed") << std::endl;
+    }
+    if (config.m_issue_timing != IssueTiming::ACCESS)
+    {
+        static char const* const c_timing_names[] = {"access", "rate", "instruction gaps", "trace"};
+
+        std::cout << std::endl;
+        std::cout << "Issue Timing: " << c_timing_names[static_cast<int>(config.m_issue_timing)] << std::endl;
+        if (config.m_issue_timing != IssueTiming::TRACE)
+            std::cout << "  Accesses per Cycle: " << config.m_accesses_per_cycle << std::endl;
+        if (config.m_issue_timing == IssueTiming::INSTRUCTION_GAPS)
+            std::cout << "  Cycles per Instruction: " << config.m_cycles_per_instruction << std::endl;
+        std::cout << "  Hit Latency: " << config.m_hit_latency << " cycles" << std::endl;
+    }
+    if (HasRegion(config))
+    {
+        std::cout << std::endl;
+        std::cout << "Region:" << std::endl;
+        if (config.m_roi)
+            std::cout << "  Region of Interest: ROI_BEGIN to ROI_END" << std::endl;
+        std::cout << "  Skip: " << config.m_skip_accesses << " accesses" << std::endl;
+        std::cout << "  Warmup: " << config.m_warmup_accesses << " accesses" << std::endl;
+        std::cout << "  Measure: " << (config.m_measure_accesses ? std::to_string(config.m_measure_accesses) + " accesses" : std::string("all")) << std::endl;
+
+        std::ios::fmtflags const flags = std::cout.flags();
+        for (AddressRange const& range : config.m_include_ranges)
+            std::cout << "  Include: 0x" << std::hex << range.m_begin << " - 0x" << range.m_end << std::dec << std::endl;
+        for (AddressRange const& range : config.m_exclude_ranges)
+            std::cout << "  Exclude: 0x" << std::hex << range.m_begin << " - 0x" << range.m_end << std::dec << std::endl;
+        std::cout.flags(flags);
+    }
+    std::cout << std::endl;
+    if (config.m_input_shm_name.empty())
+        std::cout << "Input Trace File: " << config.m_input_trace_file << std::endl;
+    else
+        std::cout << "Input Shared Memory: " << config.m_input_shm_name << " (" << config.m_input_shm_lanes << " lanes of "
+                  << config.m_input_shm_capacity << " records, " << (config.m_input_shm_wait == WaitPolicy::SPIN ? "spin" : "block") << ")" << std::endl;
+    std::cout << "Output Trace File: " << config.m_output_trace_file;
+    if (config.m_output_trace_format != TraceFormat::TEXT)
+        std::cout << " (" << trace_format::Name(config.m_output_trace_format) << ")";
     std::cout << std::endl;
-    std::cout << "Input Trace File: " << m_config.m_input_trace_file << std::endl;
-    std::cout << "Output Trace File: " << m_config.m_output_trace_file << std::endl;
     std::cout << "---------------------" << std::endl << std::endl;
 }
 
-Config const& ConfigReader::GetConfig()
+bool ConfigReader::HasRegion(Config const& config)
 {
-    return m_config;
+    return config.m_roi || config.m_skip_accesses != 0 || config.m_warmup_accesses != 0 || config.m_measure_accesses != 0 ||
+           !config.m_include_ranges.empty() || !config.m_exclude_ranges.empty();
 }
 
-void ConfigReader::ValidateConfig()
+std::vector<Config> ConfigReader::LoadSweep(std::string const& config_file)
+{
+    Config const base = Load(config_file, /* Require IO */ false);
+    auto config_data = toml::parse_file(config_file);
+
+    // Swept values, outermost first.
+    std::vector<std::string> inputs = LoadList<std::string>(config_data["SWEEP"]["inputs"], "inputs");
+    std::vector<std::int64_t> const sets = LoadList<std::int64_t>(config_data["SWEEP"]["sets"], "sets");
+    std::vector<std::int64_t> const ways = LoadList<std::int64_t>(config_data["SWEEP"]["ways"], "ways");
+    std::vector<std::int64_t> const line_sizes = LoadList<std::int64_t>(config_data["SWEEP"]["line_size"], "line_size");
+    std::vector<std::string> const write_policies = LoadList<std::string>(config_data["SWEEP"]["write_policy"], "write_policy");
+    std::vector<bool> const write_allocate = LoadList<bool>(config_data["SWEEP"]["write_allocate"], "write_allocate");
+
+    // Without swept inputs, every point simulates the input trace of the file.
+    if (inputs.empty())
+        inputs.push_back(base.m_input_trace_file);
+
+    std::vector<Config> points{base};
+    ExpandGrid(points, inputs, [](Config& config, std::string const& input) { config.m_input_trace_file = input; });
+    ExpandGrid(points, sets, [](Config& config, std::int64_t value) { config.m_sets = ToSize(value); });
+    ExpandGrid(points, ways, [](Config& config, std::int64_t value) { config.m_ways = ToSize(value); });
+    ExpandGrid(points, line_sizes, [](Config& config, std::int64_t value) { config.m_line_size = ToSize(value); });
+    ExpandGrid(points, write_policies, [](Config& config, std::string const& value) { config.m_write_policy = ParseWritePolicy(value); });
+    ExpandGrid(points, write_allocate, [](Config& config, bool value) { config.m_write_allocate = value; });
+
+    for (Config const& point : points)
+    {
+        ValidateConfig(point, /* Require IO */ false);
+
+        if (point.m_input_trace_file.empty())
+            throw std::runtime_error("Invalid configuration: A sweep needs [SWEEP] inputs or an [IO] input_trace_file.");
+
+        if (!std::filesystem::exists(point.m_input_trace_file))
+            throw std::invalid_argument("Input trace file not found: " + point.m_input_trace_file);
+    }
+
+    return points;
+}
+
+void ConfigReader::ValidateConfig(Config const& config, bool require_io)
 {
     // Validate that cache parameters are powers of two and greater than zero.
-    if (m_config.m_sets == 0)
+    if (config.m_sets == 0)
         throw std::runtime_error("Invalid configuration: Cache sets must be greater than 0.");
 
-    if (!IsPow2(m_config.m_sets))
+    if (!IsPow2(config.m_sets))
         throw std::runtime_error("Invalid configuration: Cache sets must be a power of 2.");
 
-    if (m_config.m_ways == 0)
+    if (config.m_ways == 0)
         throw std::runtime_error("Invalid configuration: Cache ways must be greater than 0.");
 
-    if (!IsPow2(m_config.m_ways))
+    if (!IsPow2(config.m_ways))
         throw std::runtime_error("Invalid configuration: Cache ways must be a power of 2.");
         
-    if (m_config.m_line_size == 0)
+    if (config.m_line_size == 0)
         throw std::runtime_error("Invalid configuration: Cache line size must be greater than 0.");
 
-    if (!IsPow2(m_config.m_line_size))
+    if (!IsPow2(config.m_line_size))
         throw std::runtime_error("Invalid configuration: Cache line size must be a power of 2.");
 
-        
+    if (config.m_organization == CacheOrganization::SECTORED)
+    {
+        // Validate the sectored geometry.
+        if (!IsPow2(config.m_sector_size) || config.m_sector_size > config.m_line_size)
+            throw std::runtime_error("Invalid configuration: Sector size must be a power of 2 no larger than the line size.");
+
+        if (config.m_line_size / config.m_sector_size > 64)
+            throw std::runtime_error("Invalid configuration: Sectored lines can hold at most 64 sectors.");
+
+        if (config.m_ways > 16)
+            throw std::runtime_error("Invalid configuration: Sectored caches support at most 16 ways.");
+
+        if (config.m_address_bits > 64)
+            throw std::runtime_error("Invalid configuration: Address bits must be at most 64.");
+    }
+
+    if (config.m_organization == CacheOrganization::SECTORED &&
+        (config.m_write_policy != WritePolicy::WRITE_BACK || !config.m_write_allocate || config.m_streaming_stores))
+        throw std::runtime_error("Invalid configuration: Sectored caches only support write-back, write-allocate stores.");
+
+    if (config.m_write_combining && (config.m_write_combining_entries == 0 || config.m_write_combining_entries > MAX_WRITE_COMBINING_ENTRIES))
+        throw std::runtime_error("Invalid configuration: Write-combining entries must be between 1 and " + std::to_string(MAX_WRITE_COMBINING_ENTRIES) + ".");
+
+    if (config.m_prefetch_distance > MAX_PREFETCH_DISTANCE)
+        throw std::runtime_error("Invalid configuration: Prefetch distance must be at most " + std::to_string(MAX_PREFETCH_DISTANCE) + ".");
+
+    if (config.m_translation)
+    {
+        // Validate the address translation.
+        if (config.m_page_size != (std::size_t(4) << 10) && config.m_page_size != (std::size_t(2) << 20))
+            throw std::runtime_error("Invalid configuration: Page size must be 4096 (4 KiB) or 2097152 (2 MiB).");
+
+        if (config.m_page_size < config.m_line_size)
+            throw std::runtime_error("Invalid configuration: Page size must be at least the line size.");
+
+        if (config.m_physical_memory == 0)
+            throw std::runtime_error("Invalid configuration: physical_memory_gb must be greater than 0.");
+
+        if (config.m_numa_nodes == 0 || config.m_physical_memory / config.m_page_size < config.m_numa_nodes)
+            throw std::runtime_error("Invalid configuration: numa_nodes must be between 1 and the amount of frames.");
+
+        if (!IsPow2(config.m_tlb_entries))
+            throw std::runtime_error("Invalid configuration: tlb_entries must be a power of 2.");
+    }
+
+    if (config.m_dram_analyzer)
+    {
+        // Validate the DRAM organization. The mapping is validated by the analyzer.
+        for (std::size_t const size : {config.m_dram_channels, config.m_dram_ranks, config.m_dram_bank_groups, config.m_dram_banks, config.m_dram_rows})
+            if (!IsPow2(size))
+                throw std::runtime_error("Invalid configuration: DRAM channels, ranks, bank_groups, banks and rows must be powers of 2.");
+
+        std::size_t const request_size = config.m_organization == CacheOrganization::SECTORED ? config.m_sector_size : config.m_line_size;
+        if (!IsPow2(config.m_dram_row_size) || config.m_dram_row_size < request_size)
+            throw std::runtime_error("Invalid configuration: DRAM row_size must be a power of 2 no smaller than a request.");
+
+        if (config.m_dram_window == 0)
+            throw std::runtime_error("Invalid configuration: DRAM window must be greater than 0.");
+    }
+
+    if (config.m_issue_timing != IssueTiming::ACCESS)
+    {
+        // Validate the issue timing. Rates are kept in 1/65536 cycle steps.
+        if (!(config.m_accesses_per_cycle > 0 && config.m_accesses_per_cycle <= 65536))
+            throw std::runtime_error("Invalid configuration: accesses_per_cycle must be greater than 0 and at most 65536.");
+
+        if (!(config.m_cycles_per_instruction >= 0 && config.m_cycles_per_instruction <= 65536))
+            throw std::runtime_error("Invalid configuration: cycles_per_instruction must be between 0 and 65536.");
+    }
+
+    // Batch mode takes the traces from elsewhere.
+    if (!require_io)
+        return;
+
     // Validate that trace file paths are not empty.
-    if (m_config.m_input_trace_file.empty())
+    if (config.m_input_trace_file.empty() && config.m_input_shm_name.empty())
         throw std::runtime_error("Invalid configuration: Input trace file path is empty.");
 
-    if (m_config.m_output_trace_file.empty())
+    if (config.m_output_trace_file.empty())
         throw std::runtime_error("Invalid configuration: Output trace file path is empty.");
 
-    
-    // Validate that input trace file exists.
-    if (!std::filesystem::exists(m_config.m_input_trace_file))
-        throw std::invalid_argument("Input trace file not found: " + m_config.m_input_trace_file);
+    if (!config.m_input_shm_name.empty())
+    {
+        // Validate the shared-memory ring. POSIX names start with a slash.
+        if (config.m_input_shm_name[0] != '/')
+            throw std::runtime_error("Invalid configuration: input_shm_name must start with '/'.");
+
+        if (config.m_input_shm_lanes == 0)
+            throw std::runtime_error("Invalid configuration: input_shm_lanes must be greater than 0.");
+
+        if (!IsPow2(config.m_input_shm_capacity))
+            throw std::runtime_error("Invalid configuration: input_shm_capacity must be a power of 2.");
+
+        // The ring is read as it comes.
+        if (HasRegion(config))
+            throw std::runtime_error("Invalid configuration: Regions and address filters need an input trace file.");
+
+        // Live records carry no timestamp.
+        if (config.m_issue_timing == IssueTiming::INSTRUCTION_GAPS || config.m_issue_timing == IssueTiming::TRACE)
+            throw std::runtime_error("Invalid configuration: Shared-memory inputs have no timestamps, use the access or rate timing.");
+    }
+    else if (!std::filesystem::exists(config.m_input_trace_file))
+    {
+        // Validate that input trace file exists.
+        throw std::invalid_argument("Input trace file not found: " + config.m_input_trace_file);
+    }
 
-    std::filesystem::path output_path(m_config.m_output_trace_file);
+    std::filesystem::path output_path(config.m_output_trace_file);
     output_path = output_path.parent_path();
     
     // Validate that output trace directory exists.
@@ -0,0 +1,234 @@
+/**
+ * @file      dram_analyzer.cpp
+ * @brief     DRAM analyzer class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/dram_analyzer.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    // Two-letter names of the fields in mapping strings, in Field order.
+    char const* const c_field_names[DramAnalyzer::FIELD_COUNT] = {"Ch", "Ra", "Bg", "Ba", "Ro", "Co"};
+
+    // Banks listed one by one in the report. Larger organizations get a summary.
+    constexpr std::size_t c_max_listed_banks = 64;
+
+    // Log2 of a power of two.
+    unsigned Log2(std::uint64_t value)
+    {
+        return static_cast<unsigned>(__builtin_ctzll(value));
+    }
+
+    // Percentage of a part, zero when the whole is zero.
+    double Percent(std::uint64_t part, std::uint64_t whole)
+    {
+        return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+    }
+}
+
+DramAnalyzer::DramAnalyzer(Config const& config, MemorySink& target) :
+        m_target(target),
+        c_mapping(config.m_dram_mapping),
+        c_sizes{config.m_dram_channels, config.m_dram_ranks, config.m_dram_bank_groups, config.m_dram_banks, config.m_dram_rows,
+                config.m_dram_row_size / (config.m_organization == CacheOrganization::SECTORED ? config.m_sector_size : config.m_line_size)},
+        c_offset_bits(Log2(config.m_organization == CacheOrganization::SECTORED ? config.m_sector_size : config.m_line_size)),
+        c_open_page(config.m_dram_page_policy == DramPagePolicy::OPEN),
+        c_xor_banks(config.m_dram_xor_banks),
+        c_window(config.m_dram_window),
+        m_mapped_bits(0),
+        m_window_remaining(config.m_dram_window),
+        m_window_bank_sum(0),
+        m_window_count(0)
+{
+    for (std::size_t const size : c_sizes)
+        if (!IsPow2(size))
+            throw std::invalid_argument("DRAM analyzer: channels, ranks, bank groups, banks, rows and columns per row must be powers of 2.");
+
+    if (c_window == 0)
+        throw std::invalid_argument("DRAM analyzer: the bank parallelism window must hold at least one request.");
+
+    // Parse the mapping, most significant field first.
+    if (c_mapping.size() != 2 * FIELD_COUNT)
+        throw std::invalid_argument("DRAM analyzer: mapping '" + c_mapping + "' must name each of Ch, Ra, Bg, Ba, Ro and Co once.");
+
+    bool seen[FIELD_COUNT] = {};
+    unsigned shift = c_offset_bits;
+
+    for (std::size_t position = c_mapping.size(); position > 0; position -= 2)
+    {
+        std::string const name = c_mapping.substr(position - 2, 2);
+        std::size_t field = 0;
+
+        while (field < FIELD_COUNT && name != c_field_names[field])
+            ++field;
+
+        if (field == FIELD_COUNT || seen[field])
+            throw std::invalid_argument("DRAM analyzer: mapping '" + c_mapping + "' must name each of Ch, Ra, Bg, Ba, Ro and Co once.");
+
+        seen[field] = true;
+        m_fields[field] = {shift, Log2(c_sizes[field])};
+        shift += m_fields[field].m_bits;
+    }
+
+    m_mapped_bits = shift;
+
+    std::size_t const bank_count = c_sizes[CHANNEL] * c_sizes[RANK] * c_sizes[BANK_GROUP] * c_sizes[BANK];
+    m_open_rows.assign(bank_count, ~std::uint64_t(0));
+    m_banks.resize(bank_count);
+    m_window_banks.assign((bank_count + 63) / 64, 0);
+}
+
+void DramAnalyzer::Record(Operation const operation, address_t const address)
+{
+    std::uint64_t const channel = Extract(address, CHANNEL);
+    std::uint64_t const rank = Extract(address, RANK);
+    std::uint64_t bank_group = Extract(address, BANK_GROUP);
+    std::uint64_t bank = Extract(address, BANK);
+
+    // Address bits above the mapping extend the row.
+    std::uint64_t row = Extract(address, ROW);
+    if (m_mapped_bits < 64)
+        row |= (address >> m_mapped_bits) << m_fields[ROW].m_bits;
+
+    // Permutation-based interleaving: rows that share a bank index spread over the banks.
+    if (c_xor_banks)
+    {
+        bank ^= row & (c_sizes[BANK] - 1);
+        bank_group ^= (row >> m_fields[BANK].m_bits) & (c_sizes[BANK_GROUP] - 1);
+    }
+
+    std::size_t const index = static_cast<std::size_t>(((channel * c_sizes[RANK] + rank) * c_sizes[BANK_GROUP] + bank_group) * c_sizes[BANK] + bank);
+    BankStats& stats = m_banks[index];
+
+    // Branch-free accounting: the outcomes of consecutive requests are hard to predict.
+    bool const write = operation == STORE;
+    stats.m_writes += write;
+    stats.m_reads += !write;
+
+    if (c_open_page)
+    {
+        std::uint64_t& open_row = m_open_rows[index];
+        bool const hit = open_row == row;
+        bool const precharged = open_row == ~std::uint64_t(0);
+
+        stats.m_hits += hit;
+        stats.m_misses += precharged;
+        stats.m_conflicts += !hit & !precharged;
+        open_row = row;
+    }
+    else
+    {
+        // The bank is precharged after every access.
+        ++stats.m_misses;
+    }
+
+    m_window_banks[index / 64] |= std::uint64_t(1) << (index % 64);
+
+    if (--m_window_remaining == 0)
+        CloseWindow();
+}
+
+void DramAnalyzer::CloseWindow()
+{
+    for (std::uint64_t& word : m_window_banks)
+    {
+        m_window_bank_sum += static_cast<std::uint64_t>(__builtin_popcountll(word));
+        word = 0;
+    }
+
+    ++m_window_count;
+    m_window_remaining = c_window;
+}
+
+void DramAnalyzer::PrintReport(std::ostream& stream) const
+{
+    std::ios::fmtflags const flags = stream.flags();
+
+    // Totals, per channel and overall.
+    std::size_t const banks_per_channel = m_banks.size() / c_sizes[CHANNEL];
+    std::vector<BankStats> channels(c_sizes[CHANNEL]);
+    BankStats total;
+
+    for (std::size_t i = 0; i < m_banks.size(); ++i)
+    {
+        for (BankStats* sum : {&channels[i / banks_per_channel], &total})
+        {
+            sum->m_reads += m_banks[i].m_reads;
+            sum->m_writes += m_banks[i].m_writes;
+            sum->m_hits += m_banks[i].m_hits;
+            sum->m_misses += m_banks[i].m_misses;
+            sum->m_conflicts += m_banks[i].m_conflicts;
+        }
+    }
+
+    std::uint64_t const requests = total.m_reads + total.m_writes;
+    auto const request_count = [](BankStats const& stats) { return stats.m_reads + stats.m_writes; };
+
+    // Imbalance: busiest over average.
+    auto const imbalance = [&](std::vector<BankStats> const& units)
+    {
+        std::uint64_t busiest = 0;
+        for (BankStats const& unit : units)
+            busiest = std::max(busiest, request_count(unit));
+
+        return requests > 0 ? static_cast<double>(busiest) * units.size() / requests : 0.0;
+    };
+
+    stream << std::endl;
+    stream << "DRAM Analysis:" << std::endl;
+    stream << "    Organization:    " << c_sizes[CHANNEL] << " channels x " << c_sizes[RANK] << " ranks x " << c_sizes[BANK_GROUP] << " bank groups x "
+           << c_sizes[BANK] << " banks, " << c_sizes[COLUMN] << " requests per row" << std::endl;
+    stream << "    Mapping:         " << c_mapping << (c_xor_banks ? " (bank XOR)" : "") << ", " << (c_open_page ? "open" : "closed") << " page" << std::endl;
+    stream << "    Requests:        " << requests << " (" << total.m_reads << " reads, " << total.m_writes << " writes)" << std::endl;
+    stream << std::fixed << std::setprecision(2);
+    stream << "    Row hits:        " << total.m_hits << " (" << Percent(total.m_hits, requests) << " %)" << std::endl;
+    stream << "    Row misses:      " << total.m_misses << " (" << Percent(total.m_misses, requests) << " %)" << std::endl;
+    stream << "    Row conflicts:   " << total.m_conflicts << " (" << Percent(total.m_conflicts, requests) << " %)" << std::endl;
+    stream << "    Parallelism:     " << (m_window_count ? static_cast<double>(m_window_bank_sum) / m_window_count : 0.0)
+           << " banks per " << c_window << " requests" << std::endl;
+    stream << "    Channel balance: " << imbalance(channels) << " (busiest / average)" << std::endl;
+    stream << "    Bank balance:    " << imbalance(m_banks) << " (busiest / average)" << std::endl;
+
+    stream << std::endl;
+    stream << "    Channel     Requests    Share    Hit rate  Conflict rate" << std::endl;
+
+    for (std::size_t i = 0; i < channels.size(); ++i)
+    {
+        std::uint64_t const count = request_count(channels[i]);
+        stream << "    " << std::setw(7) << i << std::setw(13) << count << std::setw(8) << Percent(count, requests) << " %"
+               << std::setw(10) << Percent(channels[i].m_hits, count) << " %" << std::setw(13) << Percent(channels[i].m_conflicts, count) << " %" << std::endl;
+    }
+
+    if (m_banks.size() <= c_max_listed_banks)
+    {
+        stream << std::endl;
+        stream << "    Bank (ch.ra.bg.ba)   Requests    Share    Hit rate  Conflict rate" << std::endl;
+
+        for (std::size_t i = 0; i < m_banks.size(); ++i)
+        {
+            std::size_t const ba = i % c_sizes[BANK];
+            std::size_t const bg = i / c_sizes[BANK] % c_sizes[BANK_GROUP];
+            std::size_t const ra = i / (c_sizes[BANK] * c_sizes[BANK_GROUP]) % c_sizes[RANK];
+            std::size_t const ch = i / banks_per_channel;
+            std::string const name = std::to_string(ch) + "." + std::to_string(ra) + "." + std::to_string(bg) + "." + std::to_string(ba);
+            std::uint64_t const count = request_count(m_banks[i]);
+
+            stream << "    " << std::left << std::setw(16) << name << std::right << std::setw(13) << count << std::setw(8) << Percent(count, requests) << " %"
+                   << std::setw(10) << Percent(m_banks[i].m_hits, count) << " %" << std::setw(13) << Percent(m_banks[i].m_conflicts, count) << " %" << std::endl;
+        }
+    }
+
+    stream.flags(flags);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file      mapped_arena.cpp
+ * @brief     Mapped arena class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/mapped_arena.h>
+
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+MappedArena::MappedArena(std::size_t size, bool huge_pages) :
+        c_size(size),
+        m_base(nullptr)
+{
+    if (size == 0)
+        throw std::invalid_argument("Mapped arena must hold at least one byte.");
+
+    void* const base = mmap(nullptr, c_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED)
+        throw std::runtime_error("Error: mmap failed for a " + std::to_string(c_size) + "-byte arena: " + std::strerror(errno));
+
+    m_base = static_cast<char*>(base);
+
+#ifdef MADV_HUGEPAGE
+    // Only a hint: fewer TLB misses on scattered accesses. Ignored where THP is disabled.
+    if (huge_pages)
+        madvise(m_base, c_size, MADV_HUGEPAGE);
+#endif
+}
+
+MappedArena::~MappedArena()
+{
+    munmap(m_base, c_size);
+}
@@ -0,0 +1,236 @@
+/**
+ * @file      pipeline_runner.cpp
+ * @brief     Pipeline runner class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/pipeline_runner.h>
+
+#include <utils/shm_ring.h>
+#include <utils/threading.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+PipelineRunner::PipelineRunner(bool pin_threads) :
+        c_pin_threads(pin_threads),
+        m_access_queue(PIPELINE_QUEUE_BATCHES, AccessBatch{std::vector<MemoryAccess>(ACCESS_BATCH_SIZE), 0}),
+        m_request_queue(PIPELINE_QUEUE_BATCHES, RequestBatch{std::vector<MemoryRequest>(ACCESS_BATCH_SIZE), 0}),
+        m_cache_sink(*this),
+        m_aborted(false)
+{
+}
+
+PipelineStats PipelineRunner::Run(Source const& source, CacheModel& cache, MemorySink& target)
+{
+    // Reader: decode accesses into free batches.
+    std::thread reader([&]()
+    {
+        RunStage(m_stats.m_reader, 0, [&]()
+        {
+            // Counted locally: the stats share cache lines with the other stages.
+            std::uint64_t loads = 0;
+            std::uint64_t stores = 0;
+            std::size_t count;
+
+            do
+            {
+                AccessBatch* const batch = WaitFor([this]() { return m_access_queue.TryBeginPush(); }, m_stats.m_reader.m_blocked_seconds);
+                count = batch->m_count = source(batch->m_accesses.data(), batch->m_accesses.size());
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    loads += batch->m_accesses[i].m_operation == LOAD;
+                    stores += batch->m_accesses[i].m_operation == STORE;
+                }
+
+                m_access_queue.Push();
+            }
+            while (count != 0);
+
+            m_stats.m_loads = loads;
+            m_stats.m_stores = stores;
+        });
+    });
+
+    // Cache: simulate the batches in order, then flush. Requests go to the queue sink.
+    std::thread simulator([&]()
+    {
+        RunStage(m_stats.m_cache, 1, [&]()
+        {
+            m_cache_sink.Open();
+
+            while (true)
+            {
+                AccessBatch* const batch = WaitFor([this]() { return m_access_queue.TryFront(); }, m_stats.m_cache.m_starved_seconds);
+                std::size_t const count = batch->m_count;
+
+                if (count != 0)
+                    cache.PerformOperations(batch->m_accesses.data(), count);
+
+                m_access_queue.Pop();
+
+                if (count == 0)
+                    break;
+            }
+
+            cache.Flush();
+            m_cache_sink.Close();
+        });
+    });
+
+    // Writer: hand the requests to the target in order.
+    std::thread writer([&]()
+    {
+        RunStage(m_stats.m_writer, 2, [&]()
+        {
+            while (true)
+            {
+                RequestBatch* const batch = WaitFor([this]() { return m_request_queue.TryFront(); }, m_stats.m_writer.m_starved_seconds);
+                std::size_t const count = batch->m_count;
+
+                for (std::size_t i = 0; i < count; ++i)
+                    target.Send(batch->m_requests[i]);
+
+                m_request_queue.Pop();
+
+                if (count == 0)
+                    break;
+            }
+        });
+    });
+
+    reader.join();
+    simulator.join();
+    writer.join();
+
+    if (m_error)
+        std::rethrow_exception(m_error);
+
+    return m_stats;
+}
+
+void PipelineRunner::RunStage(StageStats& stats, unsigned index, std::function<void()> const& body)
+{
+    if (c_pin_threads)
+    {
+        // One CPU per stage, wrapping around when there are fewer.
+        std::vector<unsigned> const cpus = GetAllowedCpus();
+        unsigned const cpu = cpus[index % cpus.size()];
+
+        if (PinCurrentThread(cpu))
+            stats.m_cpu = static_cast<int>(cpu);
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+
+    try
+    {
+        body();
+    }
+    catch (Aborted const&)
+    {
+        // Another stage failed and holds the error.
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> const lock(m_error_mutex);
+
+        if (!m_error)
+            m_error = std::current_exception();
+
+        m_aborted.store(true, std::memory_order_relaxed);
+    }
+
+    stats.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename TryOperation>
+auto PipelineRunner::WaitFor(TryOperation const& operation, double& stall_seconds) -> decltype(operation())
+{
+    // Nothing is timed unless the stage has to wait.
+    auto slot = operation();
+    if (slot != nullptr)
+        return slot;
+
+    auto const start = std::chrono::steady_clock::now();
+    shm_ring::Backoff backoff;
+
+    while ((slot = operation()) == nullptr)
+    {
+        if (m_aborted.load(std::memory_order_relaxed))
+            throw Aborted();
+
+        backoff.Wait();
+    }
+
+    stall_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return slot;
+}
+
+void PipelineRunner::QueueSink::Open()
+{
+    m_batch = m_runner.WaitFor([this]() { return m_runner.m_request_queue.TryBeginPush(); }, m_runner.m_stats.m_cache.m_blocked_seconds);
+    m_batch->m_count = 0;
+}
+
+void PipelineRunner::QueueSink::Publish()
+{
+    m_runner.m_request_queue.Push();
+    Open();
+}
+
+void PipelineRunner::QueueSink::Close()
+{
+    // An empty batch marks the end.
+    if (m_batch->m_count != 0)
+        Publish();
+
+    m_runner.m_request_queue.Push();
+    m_batch = nullptr;
+}
+
+void PipelineRunner::PrintReport(std::ostream& stream, PipelineStats const& stats)
+{
+    static char const* const c_stage_names[] = {"reader", "cache", "writer"};
+    StageStats const* const stages[] = {&stats.m_reader, &stats.m_cache, &stats.m_writer};
+
+    std::ios::fmtflags const flags = stream.flags();
+
+    stream << std::endl;
+    stream << "Pipeline:" << std::endl;
+    stream << "    Stage     CPU    Time (s)   Busy (s)   Starved (s)   Blocked (s)" << std::endl;
+    stream << std::fixed << std::setprecision(3);
+
+    // The stage that waits the least limits the throughput.
+    std::size_t limiter = 0;
+    double least_waiting = 0;
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        StageStats const& stage = *stages[i];
+        double const waiting = stage.m_starved_seconds + stage.m_blocked_seconds;
+
+        stream << "    " << std::left << std::setw(8) << c_stage_names[i] << std::right << std::setw(5)
+               << (stage.m_cpu < 0 ? std::string("-") : std::to_string(stage.m_cpu)) << std::setw(12) << stage.m_seconds
+               << std::setw(11) << stage.m_seconds - waiting << std::setw(14) << stage.m_starved_seconds << std::setw(14) << stage.m_blocked_seconds << std::endl;
+
+        if (i == 0 || waiting < least_waiting)
+        {
+            limiter = i;
+            least_waiting = waiting;
+        }
+    }
+
+    stream << "    Limited by:  " << c_stage_names[limiter] << std::endl;
+
+    stream.flags(flags);
+}
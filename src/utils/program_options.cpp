@@ -18,7 +18,17 @@
 #include <iostream>
 #include <stdexcept>
 
-ProgramOptions::ProgramOptions(int argc, char* argv[]) : m_config_file(DEFAULT_CONFIG_FILE), m_should_exit(false)
+ProgramOptions::ProgramOptions(int argc, char* argv[]) :
+        m_config_file(DEFAULT_CONFIG_FILE),
+        m_batch_output_directory(DEFAULT_BATCH_OUTPUT_DIRECTORY),
+        m_batch_threads(0),
+        m_slices(0),
+        m_slice_warmup(DEFAULT_SLICE_WARMUP),
+        m_verify_slices(false),
+        m_pin_threads(false),
+        m_pipeline(false),
+        m_sweep_step(SweepStep::NONE),
+        m_should_exit(false)
 {
     // Parse command-line arguments.
     for (int i = 1; i < argc; ++i)
@@ -39,6 +49,50 @@ ProgramOptions::ProgramOptions(int argc, char* argv[]) : m_config_file(DEFAULT_C
             else
                 throw std::invalid_argument("The -f option requires a filename argument.");
         } 
+        else if (argument == "--batch" || argument == "--output-dir" || argument == "--report" || argument == "--jobs" || argument == "--slices" || argument == "--warmup" || argument == "--result-store" ||
+                 argument == "--sweep-plan" || argument == "--sweep-work" || argument == "--sweep-merge")
+        {
+            // Sanity Check: Is there a next argument?
+            if (i + 1 >= argc)
+                throw std::invalid_argument("The " + argument + " option requires an argument.");
+
+            std::string const value = argv[++i];
+
+            if (argument == "--batch")
+                m_batch_inputs = value;
+            else if (argument == "--output-dir")
+                m_batch_output_directory = value;
+            else if (argument == "--report")
+                m_batch_report_file = value;
+            else if (argument == "--slices")
+                m_slices = std::stoul(value);
+            else if (argument == "--warmup")
+                m_slice_warmup = std::stoull(value);
+            else if (argument == "--result-store")
+                m_result_store = value;
+            else if (argument == "--sweep-plan" || argument == "--sweep-work" || argument == "--sweep-merge")
+            {
+                if (m_sweep_step != SweepStep::NONE)
+                    throw std::invalid_argument("Only one of --sweep-plan, --sweep-work and --sweep-merge can be given.");
+
+                m_sweep_step = argument == "--sweep-plan" ? SweepStep::PLAN : argument == "--sweep-work" ? SweepStep::WORK : SweepStep::MERGE;
+                m_sweep_directory = value;
+            }
+            else
+                m_batch_threads = static_cast<unsigned>(std::stoul(value));
+        }
+        else if (argument == "--pin")
+        {
+            m_pin_threads = true;
+        }
+        else if (argument == "--verify")
+        {
+            m_verify_slices = true;
+        }
+        else if (argument == "--pipeline")
+        {
+            m_pipeline = true;
+        }
         else if (argument == "-v")
         {
             PrintVersion();
@@ -55,6 +109,22 @@ ProgramOptions::ProgramOptions(int argc, char* argv[]) : m_config_file(DEFAULT_C
         }
     }
 
+    if (m_slices != 0 && !m_batch_inputs.empty())
+        throw std::invalid_argument("The --slices and --batch options cannot be combined.");
+
+    if (m_slices != 0 && !m_result_store.empty())
+        throw std::invalid_argument("Time-sliced runs are approximate and cannot use the --result-store option.");
+
+    if (m_pipeline && (m_slices != 0 || !m_batch_inputs.empty()))
+        throw std::invalid_argument("The --pipeline option only applies to single, exact runs.");
+
+    if (m_sweep_step != SweepStep::NONE && (m_slices != 0 || !m_batch_inputs.empty() || m_pipeline))
+        throw std::invalid_argument("Sweeps cannot be combined with the --batch, --slices and --pipeline options.");
+
+    // Workers and merges take everything from the sweep directory.
+    if (m_sweep_step == SweepStep::WORK || m_sweep_step == SweepStep::MERGE)
+        return;
+
     // Verify if the configuration file exists.
     if (!std::filesystem::exists(m_config_file))
         throw std::invalid_argument("Configuration file not found: " + m_config_file);
@@ -71,7 +141,23 @@ void ProgramOptions::PrintUsage() const
 
     std::cout << "Usage: " << SIMULATOR_NAME << " [options]" << std::endl
               << "Options: " << std::endl
-              << "  -f <file>   Specify configuration file (Default: " << DEFAULT_CONFIG_FILE << ")" << std::endl
-              << "  -v          Show version information" << std::endl
-              << "  -h, --help  Show this help message" << std::endl;
+              << "  -f <file>             Specify configuration file (Default: " << DEFAULT_CONFIG_FILE << ")" << std::endl
+              << "  -v                    Show version information" << std::endl
+              << "  -h, --help            Show this help message" << std::endl
+              << "  --result-store <dir>  Reuse the outputs of runs already simulated from a directory, and store new ones" << std::endl
+              << "  --pipeline            Read, simulate and write the trace on three threads (--pin binds each to a CPU)" << std::endl
+              << "Batch mode (the cache comes from the configuration file, its [IO] section is ignored):" << std::endl
+              << "  --batch <inputs>      Simulate a directory of *.trace files, a glob pattern or a manifest (one trace per line)" << std::endl
+              << "  --output-dir <dir>    Directory of the output traces (Default: " << DEFAULT_BATCH_OUTPUT_DIRECTORY << ")" << std::endl
+              << "  --report <file>       CSV report (Default: <output-dir>/batch_report.csv)" << std::endl
+              << "  --jobs <n>            Worker threads (Default: one per CPU)" << std::endl
+              << "  --pin                 Bind each worker thread to a CPU" << std::endl
+              << "Time-sliced mode (approximate, one trace from the configuration file):" << std::endl
+              << "  --slices <n>          Simulate the trace as n slices in parallel (uses --jobs and --pin)" << std::endl
+              << "  --warmup <n>          Accesses replayed before each slice to warm the cache up (Default: " << DEFAULT_SLICE_WARMUP << ")" << std::endl
+              << "  --verify              Also run the exact simulation and report the error of every slice" << std::endl
+              << "Sweep mode (jobs shared through a directory; start any amount of workers on any host that mounts it):" << std::endl
+              << "  --sweep-plan <dir>    Expand the [SWEEP] grid of the configuration file into a manifest of jobs in dir" << std::endl
+              << "  --sweep-work <dir>    Claim and run jobs of dir until none is left (uses --jobs, --pin and --result-store)" << std::endl
+              << "  --sweep-merge <dir>   Gather the job results of dir into a table (Default: <dir>/results.csv, or --report <file>)" << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+/**
+ * @file      result_store.cpp
+ * @brief     Result store class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/result_store.h>
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Blocks of the input trace hashed into the fingerprint, and their size.
+    constexpr std::uint64_t c_sample_count = 64;
+    constexpr std::uint64_t c_sample_size = 4096;
+
+    // Files of an entry.
+    constexpr char const* c_key_file = "key";
+    constexpr char const* c_stats_file = "stats";
+    constexpr char const* c_output_file = "output.trace";
+
+    // Distinguishes the staging directories of the threads of a process.
+    std::atomic<std::uint64_t> s_staging_sequence{0};
+
+    // FNV-1a.
+    std::uint64_t Hash(char const* data, std::size_t size, std::uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ull;
+
+        return hash;
+    }
+
+    // Fixed-width hexadecimal.
+    std::string Hex(std::uint64_t value)
+    {
+        std::ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << value;
+        return stream.str();
+    }
+
+    // Hash of evenly spaced blocks of a file, the first and the last included. Small files are hashed whole.
+    std::uint64_t SampleHash(std::string const& file, std::uint64_t size)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        if (!stream.is_open())
+            throw std::runtime_error("Could not open input trace " + file);
+
+        std::vector<char> block(c_sample_size);
+        std::uint64_t hash = Hash(nullptr, 0);
+
+        if (size <= c_sample_count * c_sample_size)
+        {
+            while (stream.read(block.data(), block.size()) || stream.gcount() > 0)
+                hash = Hash(block.data(), static_cast<std::size_t>(stream.gcount()), hash);
+
+            return hash;
+        }
+
+        for (std::uint64_t i = 0; i < c_sample_count; ++i)
+        {
+            stream.seekg(static_cast<std::streamoff>((size - c_sample_size) * i / (c_sample_count - 1)));
+
+            if (!stream.read(block.data(), block.size()))
+                throw std::runtime_error("Could not read input trace " + file);
+
+            hash = Hash(block.data(), block.size(), hash);
+        }
+
+        return hash;
+    }
+
+    // Contents of a file. Empty if it cannot be read.
+    std::string ReadFile(std::filesystem::path const& file)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        std::ostringstream contents;
+
+        if (stream.is_open())
+            contents << stream.rdbuf();
+
+        return contents.str();
+    }
+
+    // Write a file, or throw.
+    void WriteFile(std::filesystem::path const& file, std::string const& contents)
+    {
+        std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+
+        if (!stream.write(contents.data(), contents.size()) || !stream.flush())
+            throw std::runtime_error("Could not write to result store file " + file.string());
+    }
+
+    // Make destination share the contents of source: a hard link, or a copy across file systems.
+    void LinkOrCopy(std::filesystem::path const& source, std::filesystem::path const& destination)
+    {
+        std::error_code error;
+        std::filesystem::create_hard_link(source, destination, error);
+
+        if (error)
+            std::filesystem::copy_file(source, destination, std::filesystem::copy_options::overwrite_existing);
+    }
+}
+
+ResultStore::ResultStore(std::string const& directory) : c_directory(directory)
+{
+    std::filesystem::create_directories(c_directory);
+}
+
+std::string ResultStore::Fingerprint(std::string const& input_file, Config const& config)
+{
+    struct stat status;
+    if (stat(input_file.c_str(), &status) != 0)
+        throw std::runtime_error("Could not open input trace " + input_file);
+
+    std::uint64_t const size = static_cast<std::uint64_t>(status.st_size);
+    std::uint64_t const modified = static_cast<std::uint64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+
+    std::ostringstream key;
+
+    // Simulator.
+    key << "version " << SIMULATOR_VERSION;
+#ifdef TBRIDGE_GIT_REVISION
+    key << " " << TBRIDGE_GIT_REVISION;
+#endif
+    key << "\n";
+
+    // Input trace.
+    key << "trace_size " << size << "\n"
+        << "trace_mtime_ns " << modified << "\n"
+        << "trace_hash " << Hex(SampleHash(input_file, size)) << "\n";
+
+    // Settings that change the output. The prefetch distance and the paths do not.
+    key << "sets " << config.m_sets << "\n"
+        << "ways " << config.m_ways << "\n"
+        << "line_size " << config.m_line_size << "\n"
+        << "organization " << (config.m_organization == CacheOrganization::SECTORED ? "sectored" : "set_associative") << "\n"
+        << "sector_size " << config.m_sector_size << "\n"
+        << "address_bits " << config.m_address_bits << "\n"
+        << "flush_interval " << config.m_flush_interval << "\n"
+        << "flush_mode " << (config.m_flush_mode == FlushMode::WRITEBACK ? "writeback" : "invalidate") << "\n"
+        << "write_policy " << (config.m_write_policy == WritePolicy::WRITE_THROUGH ? "write_through" : "write_back") << " "
+        << config.m_write_allocate << " " << config.m_streaming_stores << "\n"
+        << "write_combining " << (config.m_write_combining ? config.m_write_combining_entries : 0) << "\n"
+        << "output_trace_format " << trace_format::Name(config.m_output_trace_format) << "\n";
+
+    if (config.m_issue_timing != IssueTiming::ACCESS)
+        key << "issue_timing " << static_cast<int>(config.m_issue_timing) << " " << std::setprecision(17) << config.m_accesses_per_cycle << " "
+            << config.m_cycles_per_instruction << " " << config.m_hit_latency << "\n";
+
+    if (ConfigReader::HasRegion(config))
+    {
+        key << "region " << config.m_roi << " " << config.m_skip_accesses << " " << config.m_warmup_accesses << " " << config.m_measure_accesses << "\n";
+
+        for (AddressRange const& range : config.m_include_ranges)
+            key << "include " << range.m_begin << " " << range.m_end << "\n";
+        for (AddressRange const& range : config.m_exclude_ranges)
+            key << "exclude " << range.m_begin << " " << range.m_end << "\n";
+    }
+
+    if (config.m_translation)
+        key << "translation " << config.m_page_size << " " << static_cast<int>(config.m_page_allocation) << " " << config.m_physical_memory << " "
+            << config.m_numa_nodes << " " << config.m_translation_seed << " " << config.m_tlb_entries << " " << config.m_page_walks << "\n";
+
+    return key.str();
+}
+
+std::string ResultStore::GetEntryPath(std::string const& fingerprint) const
+{
+    // Two differently seeded hashes. Lookups compare the whole fingerprint, so a collision is only a miss.
+    std::string const name = Hex(Hash(fingerprint.data(), fingerprint.size())) + Hex(Hash(fingerprint.data(), fingerprint.size(), 0x84222325cbf29ce4ull));
+    return (c_directory / name).string();
+}
+
+bool ResultStore::Fetch(std::string const& fingerprint, std::string const& output_file, RunStats& stats) const
+{
+    std::filesystem::path const entry = GetEntryPath(fingerprint);
+
+    if (ReadFile(entry / c_key_file) != fingerprint)
+        return false;
+
+    std::istringstream stream(ReadFile(entry / c_stats_file));
+    std::string name;
+    std::size_t fields = 0;
+
+    while (stream >> name)
+    {
+        if (name == "loads")
+            stream >> stats.m_loads;
+        else if (name == "stores")
+            stream >> stats.m_stores;
+        else if (name == "dram_reads")
+            stream >> stats.m_dram_reads;
+        else if (name == "dram_writes")
+            stream >> stats.m_dram_writes;
+        else if (name == "seconds")
+            stream >> stats.m_seconds;
+        else
+            return false;
+
+        ++fields;
+    }
+
+    if (fields != 5)
+        return false;
+
+    // Replace the output with the stored trace.
+    std::error_code error;
+    std::filesystem::remove(output_file, error);
+    LinkOrCopy(entry / c_output_file, output_file);
+
+    return true;
+}
+
+void ResultStore::Store(std::string const& fingerprint, std::string const& output_file, RunStats const& stats) const
+{
+    std::filesystem::path const entry = GetEntryPath(fingerprint);
+
+    if (std::filesystem::exists(entry))
+        return;
+
+    // Build the entry aside and publish it with a single rename.
+    std::filesystem::path const staging = c_directory / (".staging-" + entry.filename().string() + "-" + std::to_string(getpid()) + "-" + std::to_string(s_staging_sequence++));
+    std::error_code error;
+
+    try
+    {
+        std::filesystem::create_directory(staging);
+        LinkOrCopy(output_file, staging / c_output_file);
+
+        std::ostringstream contents;
+        contents << "loads " << stats.m_loads << "\n"
+                 << "stores " << stats.m_stores << "\n"
+                 << "dram_reads " << stats.m_dram_reads << "\n"
+                 << "dram_writes " << stats.m_dram_writes << "\n"
+                 << "seconds " << stats.m_seconds << "\n";
+
+        WriteFile(staging / c_stats_file, contents.str());
+        WriteFile(staging / c_key_file, fingerprint);
+
+        // Fails if a concurrent run published the entry first; its result is as good as ours.
+        std::filesystem::rename(staging, entry, error);
+    }
+    catch (...)
+    {
+        std::filesystem::remove_all(staging, error);
+        throw;
+    }
+
+    if (error)
+        std::filesystem::remove_all(staging, error);
+}
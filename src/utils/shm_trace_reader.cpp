@@ -0,0 +1,198 @@
+/**
+ * @file      shm_trace_reader.cpp
+ * @brief     Shared-memory trace reader class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/shm_trace_reader.h>
+
+#include <iostream>
+#include <new>
+
+ShmTraceReader::ShmTraceReader(std::string const& name, std::uint32_t lanes, std::uint64_t capacity, WaitPolicy wait_policy)
+    : c_name(name), c_lanes(lanes), c_capacity(capacity), c_wait_policy(wait_policy), m_base(nullptr), m_size(0), m_header(nullptr),
+      m_next_lane(0), m_buffer(c_buffer_size), m_buffer_position(0), m_buffer_count(0)
+{
+    if (lanes == 0 || !IsPow2(capacity))
+        throw std::invalid_argument("ShmTraceReader Error: The ring needs at least one lane and a power of two capacity.");
+
+    int fd = shm_open(c_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    // A previous run that crashed may have left the segment behind. Only a segment without a live consumer is
+    // removed: producers may be attached to the ring of another reader.
+    if (fd == -1 && errno == EEXIST)
+    {
+        if (!IsStale(c_name))
+            throw std::runtime_error("Error: Shared memory ring " + c_name + " is in use by another T-Bridge process.");
+
+        shm_unlink(c_name.c_str());
+        fd = shm_open(c_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+
+    if (fd == -1)
+        throw std::runtime_error("Error: Could not create shared memory ring " + c_name + ": " + std::strerror(errno));
+
+    m_size = shm_ring::SegmentSize(c_lanes, c_capacity);
+
+    if (ftruncate(fd, m_size) == -1)
+    {
+        close(fd);
+        shm_unlink(c_name.c_str());
+        throw std::runtime_error("Error: Could not size shared memory ring " + c_name + ": " + std::strerror(errno));
+    }
+
+    m_base = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (m_base == MAP_FAILED)
+    {
+        shm_unlink(c_name.c_str());
+        throw std::runtime_error("Error: mmap failed for shared memory ring " + c_name);
+    }
+
+    // The segment is zero-filled. Construct the control blocks in place.
+    m_header = new (m_base) shm_ring::Header();
+    m_header->m_version = shm_ring::c_version;
+    m_header->m_lanes = c_lanes;
+    m_header->m_capacity = c_capacity;
+    m_header->m_claimed_lanes.store(0, std::memory_order_relaxed);
+    m_header->m_finished.store(0, std::memory_order_relaxed);
+    m_header->m_producer_pid.store(0, std::memory_order_relaxed);
+    m_header->m_consumer_pid = getpid();
+    m_header->m_consumer_closed.store(0, std::memory_order_relaxed);
+
+    for (std::uint32_t lane = 0; lane < c_lanes; ++lane)
+        new (shm_ring::GetLane(m_base, lane)) shm_ring::Lane{{0}, {0}};
+
+    // Publish the segment. Producers only attach once they see the signature.
+    m_header->m_magic.store(shm_ring::c_magic, std::memory_order_release);
+
+    std::cout << "Waiting for a tracer on shared memory ring " << c_name << " (" << c_lanes << " lanes of "
+              << c_capacity << " records)..." << std::endl;
+}
+
+ShmTraceReader::~ShmTraceReader()
+{
+    // Producers still waiting for space give up instead of waiting forever.
+    m_header->m_consumer_closed.store(1, std::memory_order_release);
+    munmap(m_base, m_size);
+
+    shm_unlink(c_name.c_str());
+}
+
+bool ShmTraceReader::GetNextAccess(Operation& op_type, address_t& address)
+{
+    // Refill the buffer.
+    if (m_buffer_position == m_buffer_count)
+    {
+        m_buffer_count = GetNextAccesses(m_buffer.data(), m_buffer.size());
+        m_buffer_position = 0;
+
+        if (m_buffer_count == 0)
+            return false;
+    }
+
+    op_type = m_buffer[m_buffer_position].m_operation;
+    address = m_buffer[m_buffer_position].m_address;
+    ++m_buffer_position;
+
+    return true;
+}
+
+std::size_t ShmTraceReader::GetNextAccesses(MemoryAccess* accesses, std::size_t max_count)
+{
+    shm_ring::Backoff backoff(c_wait_policy == WaitPolicy::SPIN);
+
+    while (true)
+    {
+        // Read the flag before draining: every record published before it is visible afterwards.
+        bool const finished = m_header->m_finished.load(std::memory_order_acquire);
+
+        std::size_t const count = Drain(accesses, max_count);
+        if (count != 0)
+            return count;
+
+        if (finished)
+            return 0;
+
+        if (backoff.Wait())
+            CheckProducer();
+    }
+}
+
+std::size_t ShmTraceReader::Drain(MemoryAccess* accesses, std::size_t max_count)
+{
+    std::uint64_t const mask = c_capacity - 1;
+
+    for (std::uint32_t i = 0; i < c_lanes; ++i)
+    {
+        std::uint32_t const lane_index = m_next_lane;
+        m_next_lane = (m_next_lane + 1 == c_lanes) ? 0 : m_next_lane + 1;
+
+        shm_ring::Lane* const lane = shm_ring::GetLane(m_base, lane_index);
+        std::uint64_t const tail = lane->m_tail.load(std::memory_order_relaxed);
+        std::uint64_t const head = lane->m_head.load(std::memory_order_acquire);
+
+        if (head == tail)
+            continue;
+
+        std::uint64_t const* const records = shm_ring::GetRecords(m_base, c_lanes, c_capacity, lane_index);
+        std::size_t const count = std::min<std::uint64_t>(head - tail, max_count);
+
+        // Decode the batch.
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            std::uint64_t const record = records[(tail + j) & mask];
+            accesses[j].m_operation = (record & shm_ring::c_store_bit) ? STORE : LOAD;
+            accesses[j].m_address = record & ~shm_ring::c_store_bit;
+            accesses[j].m_timestamp = TIMESTAMP_MAX;
+        }
+
+        // Hand the records back to the producer.
+        lane->m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    return 0;
+}
+
+bool ShmTraceReader::IsStale(std::string const& name)
+{
+    int const fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        return errno == ENOENT;
+
+    struct stat sb;
+    if (fstat(fd, &sb) == -1 || static_cast<std::size_t>(sb.st_size) < sizeof(shm_ring::Header))
+    {
+        // Never sized: its creator died right after creating it.
+        close(fd);
+        return true;
+    }
+
+    void* const base = mmap(nullptr, sizeof(shm_ring::Header), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED)
+        return false;
+
+    // A segment without a signature was never initialized: its creator died while setting it up.
+    auto const* const header = static_cast<shm_ring::Header const*>(base);
+    bool const stale = header->m_magic.load(std::memory_order_acquire) != shm_ring::c_magic || shm_ring::IsConsumerGone(header);
+    munmap(base, sizeof(shm_ring::Header));
+    return stale;
+}
+
+void ShmTraceReader::CheckProducer() const
+{
+    pid_t const pid = m_header->m_producer_pid.load(std::memory_order_relaxed);
+
+    if (pid != 0 && kill(pid, 0) == -1 && errno == ESRCH)
+        throw std::runtime_error("ShmTraceReader Error: The tracer (pid " + std::to_string(pid) + ") exited without finishing the stream.");
+}
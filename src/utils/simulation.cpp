@@ -0,0 +1,66 @@
+/**
+ * @file      simulation.cpp
+ * @brief     Simulation building blocks implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-19
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/simulation.h>
+
+#include <iostream>
+#include <vector>
+
+SinkChain::SinkChain(Config const& config, MemorySink& destination, bool analyze) : m_sink(&destination)
+{
+    // Analyze the requests on their way to the destination, if enabled.
+    if (analyze && config.m_dram_analyzer)
+    {
+        m_analyzer = std::make_unique<DramAnalyzer>(config, *m_sink);
+        m_sink = m_analyzer.get();
+    }
+
+    // Combine the requests in front of memory, if enabled.
+    if (config.m_write_combining)
+    {
+        m_write_combining = std::make_unique<WriteCombiningBuffer>(config.m_write_combining_entries, *m_sink);
+        m_sink = m_write_combining.get();
+    }
+}
+
+void SinkChain::Drain()
+{
+    // Requests still held by the write-combining buffer go to memory last.
+    if (m_write_combining)
+        m_write_combining->Drain();
+}
+
+void EnterRegion(Config const& config, TraceReader& trace_reader, CacheModel& cache, GatedSink* warmup_gate, bool quiet)
+{
+    if (!ConfigReader::HasRegion(config))
+        return;
+
+    // Fast-forward by seeking past the skipped lines, then warm the cache up without output.
+    TraceRegion const region = trace_reader.FindRegion(config.m_roi, config.m_skip_accesses, config.m_warmup_accesses, config.m_measure_accesses);
+    trace_reader.SetFilter(config.m_include_ranges, config.m_exclude_ranges);
+
+    if (!quiet)
+        std::cout << "Fast-forwarding " << trace_reader.CountLines(trace_reader.GetDataBegin(), region.m_warmup_begin) << " lines, warming up on "
+                  << trace_reader.CountLines(region.m_warmup_begin, region.m_measure_begin) << " lines..." << std::endl;
+
+    trace_reader.SetRange(region.m_warmup_begin, region.m_measure_begin);
+    std::vector<MemoryAccess> batch(ACCESS_BATCH_SIZE);
+    std::size_t count;
+
+    while ((count = trace_reader.GetNextAccesses(batch.data(), batch.size())) != 0)
+        cache.PerformOperations(batch.data(), count);
+
+    if (warmup_gate)
+        warmup_gate->SetOpen(true);
+
+    trace_reader.SetRange(region.m_measure_begin, region.m_measure_end);
+}
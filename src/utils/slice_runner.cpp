@@ -0,0 +1,276 @@
+/**
+ * @file      slice_runner.cpp
+ * @brief     Slice runner class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/slice_runner.h>
+
+#include <core/cache_model.h>
+#include <utils/memory_sink.h>
+#include <utils/simulation.h>
+#include <utils/thread_pool.h>
+#include <utils/threading.h>
+#include <utils/trace_engine.h>
+#include <utils/trace_reader.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    // Signed relative error in percent. Zero when both counts are zero.
+    double RelativeError(std::uint64_t approximate, std::uint64_t exact)
+    {
+        if (exact == 0)
+            return approximate == 0 ? 0.0 : 100.0;
+
+        return (static_cast<double>(approximate) - static_cast<double>(exact)) / static_cast<double>(exact) * 100;
+    }
+}
+
+SliceRunner::SliceRunner(Config const& config, std::size_t slices, std::uint64_t warmup_accesses, unsigned threads, bool pin_threads)
+    : c_config(config), c_slice_count(slices), c_warmup_accesses(warmup_accesses), c_thread_count(ResolveThreadCount(threads)), c_pin_threads(pin_threads)
+{
+    if (c_slice_count == 0)
+        throw std::invalid_argument("Time slicing needs at least one slice.");
+
+    if (!c_config.m_input_shm_name.empty())
+        throw std::invalid_argument("Time slicing needs an input trace file, not a shared-memory input.");
+
+    if (c_config.m_translation)
+        throw std::invalid_argument("Time slicing cannot translate addresses: frames depend on the first-touch order of the whole trace.");
+
+    if (c_config.m_issue_timing == IssueTiming::RATE || c_config.m_issue_timing == IssueTiming::INSTRUCTION_GAPS)
+        throw std::invalid_argument("Time slicing cannot model the issue rate: issue cycles depend on every access before them.");
+
+    // Each slice restarts the access clock, so its cycles would go back at every slice boundary.
+    if (c_config.m_issue_timing == IssueTiming::ACCESS && c_config.m_output_trace_format != TraceFormat::TEXT)
+        throw std::invalid_argument("Time slicing cannot stamp requests with the access clock: write a text output, or take the cycles from the trace (mode = \"trace\").");
+
+    if (ConfigReader::HasRegion(c_config))
+        throw std::invalid_argument("Time slicing cannot restrict the trace to a region or filter its addresses.");
+}
+
+std::vector<SliceResult> SliceRunner::Run()
+{
+    std::vector<SliceResult> results(c_slice_count);
+
+    {
+        // Cut the trace at line starts and find where each warmup window begins.
+        TraceReader trace_reader(c_config.m_input_trace_file);
+        std::vector<std::size_t> const offsets = trace_reader.GetSliceOffsets(c_slice_count);
+
+        for (std::size_t i = 0; i < c_slice_count; ++i)
+        {
+            results[i].m_begin = offsets[i];
+            results[i].m_end = offsets[i + 1];
+            results[i].m_warmup_begin = trace_reader.RewindLines(offsets[i], c_warmup_accesses);
+        }
+    }
+
+    std::vector<ThreadPool::Task> tasks;
+
+    for (std::size_t i = 0; i < c_slice_count; ++i)
+        tasks.push_back([this, &results, i](unsigned) { RunSlice(results[i], SliceOutputFile(i), i + 1 == c_slice_count); });
+
+    try
+    {
+        ThreadPool pool(c_thread_count, c_pin_threads);
+        pool.Run(std::move(tasks));
+
+        // Concatenate the slice outputs in trace order.
+        if (std::filesystem::exists(c_config.m_output_trace_file))
+            std::cout << "Overwriting previous output trace: " << c_config.m_output_trace_file << std::endl;
+
+        // An output hard-linked to a stored result is unlinked first, so truncating it leaves the result intact.
+        std::error_code error;
+        if (std::filesystem::is_regular_file(c_config.m_output_trace_file, error) && std::filesystem::hard_link_count(c_config.m_output_trace_file, error) > 1)
+            std::filesystem::remove(c_config.m_output_trace_file, error);
+
+        std::ofstream output(c_config.m_output_trace_file, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+            throw std::runtime_error("Could not write to output file " + c_config.m_output_trace_file);
+
+        for (std::size_t i = 0; i < c_slice_count; ++i)
+        {
+            std::ifstream slice_output(SliceOutputFile(i), std::ios::binary);
+
+            // Binary outputs keep only the header of the first slice.
+            if (i != 0 && c_config.m_output_trace_format == TraceFormat::BINARY)
+                slice_output.seekg(sizeof(trace_format::Header));
+
+            // An empty stream buffer sets failbit on the output; empty slices are expected.
+            if (slice_output.peek() != std::ifstream::traits_type::eof())
+                output << slice_output.rdbuf();
+        }
+
+        if (!output.flush())
+            throw std::runtime_error("Could not write to output file " + c_config.m_output_trace_file);
+    }
+    catch (...)
+    {
+        for (std::size_t i = 0; i < c_slice_count; ++i)
+            std::filesystem::remove(SliceOutputFile(i));
+
+        throw;
+    }
+
+    for (std::size_t i = 0; i < c_slice_count; ++i)
+        std::filesystem::remove(SliceOutputFile(i));
+
+    return results;
+}
+
+void SliceRunner::RunSlice(SliceResult& result, std::string const& output_file, bool last) const
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    // Every slice owns its output, reader and cache. The gate discards the requests of the warmup.
+    TraceEngine trace_engine(output_file, /* Quiet */ true, c_config.m_output_trace_format);
+    SinkChain sink_chain(c_config, trace_engine, /* Analyze */ false);
+    GatedSink gate(sink_chain.GetSink());
+    TraceReader trace_reader(c_config.m_input_trace_file);
+    std::unique_ptr<CacheModel> cache = CreateCacheModel(c_config, gate);
+
+    std::vector<MemoryAccess> batch(ACCESS_BATCH_SIZE);
+    std::size_t count;
+
+    // Warmup replay.
+    trace_reader.SetRange(result.m_warmup_begin, result.m_begin);
+
+    while ((count = trace_reader.GetNextAccesses(batch.data(), batch.size())) != 0)
+    {
+        result.m_warmup_accesses += count;
+        cache->PerformOperations(batch.data(), count);
+    }
+
+    // Simulated slice.
+    gate.SetOpen(true);
+    trace_reader.SetRange(result.m_begin, result.m_end);
+
+    while ((count = trace_reader.GetNextAccesses(batch.data(), batch.size())) != 0)
+    {
+        result.m_accesses += count;
+        cache->PerformOperations(batch.data(), count);
+    }
+
+    // The lines left in the cache belong to the following slices, except at the end of the trace.
+    if (last)
+        cache->Flush();
+
+    // The write-combining buffer empties at the end of every slice: the next slice does not share it.
+    sink_chain.Drain();
+    gate.SetOpen(false);
+
+    result.m_dram_reads = trace_engine.GetRequestCount(LOAD);
+    result.m_dram_writes = trace_engine.GetRequestCount(STORE);
+    trace_engine.Shutdown();
+
+    result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SliceRunner::Verify(std::vector<SliceResult>& results) const
+{
+    CountingSink counts;
+    SinkChain sink_chain(c_config, counts, /* Analyze */ false);
+    TraceReader trace_reader(c_config.m_input_trace_file);
+    std::unique_ptr<CacheModel> cache = CreateCacheModel(c_config, sink_chain.GetSink());
+
+    std::vector<MemoryAccess> batch(ACCESS_BATCH_SIZE);
+    std::size_t count;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        std::uint64_t const loads = counts.m_loads;
+        std::uint64_t const stores = counts.m_stores;
+
+        // Same accesses as the slice, on a cache that has seen the whole trace before them.
+        trace_reader.SetRange(results[i].m_begin, results[i].m_end);
+
+        while ((count = trace_reader.GetNextAccesses(batch.data(), batch.size())) != 0)
+            cache->PerformOperations(batch.data(), count);
+
+        if (i + 1 == results.size())
+        {
+            cache->Flush();
+            sink_chain.Drain();
+        }
+
+        results[i].m_exact_dram_reads = counts.m_loads - loads;
+        results[i].m_exact_dram_writes = counts.m_stores - stores;
+    }
+}
+
+void SliceRunner::PrintReport(std::ostream& stream, std::vector<SliceResult> const& results, double wall_seconds, bool verified) const
+{
+    std::ios::fmtflags const flags = stream.flags();
+
+    std::uint64_t accesses = 0;
+    std::uint64_t warmup_accesses = 0;
+    std::uint64_t reads = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t exact_reads = 0;
+    std::uint64_t exact_writes = 0;
+
+    stream << std::endl;
+    stream << "Time Slices:" << std::endl;
+    stream << "    Slice    Warmup    Accesses    DRAM reads   DRAM writes     Time" << (verified ? "   Read error  Write error" : "") << std::endl;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        SliceResult const& result = results[i];
+
+        stream << std::fixed << std::setprecision(2)
+               << "    " << std::setw(5) << i << std::setw(10) << result.m_warmup_accesses << std::setw(12) << result.m_accesses
+               << std::setw(14) << result.m_dram_reads << std::setw(14) << result.m_dram_writes << std::setw(7) << result.m_seconds << " s";
+
+        if (verified)
+            stream << std::setw(12) << RelativeError(result.m_dram_reads, result.m_exact_dram_reads) << " %"
+                   << std::setw(11) << RelativeError(result.m_dram_writes, result.m_exact_dram_writes) << " %";
+
+        stream << std::defaultfloat << std::endl;
+
+        accesses += result.m_accesses;
+        warmup_accesses += result.m_warmup_accesses;
+        reads += result.m_dram_reads;
+        writes += result.m_dram_writes;
+        exact_reads += result.m_exact_dram_reads;
+        exact_writes += result.m_exact_dram_writes;
+    }
+
+    stream << std::endl;
+    stream << "Time Slice Summary:" << std::endl;
+    stream << "    Slices:          " << results.size() << " on " << c_thread_count << " workers" << (c_pin_threads ? " (pinned)" : "") << std::endl;
+    stream << "    Accesses:        " << accesses << " (+" << warmup_accesses << " replayed for warmup)" << std::endl;
+    stream << "    DRAM reads:      " << reads << std::endl;
+    stream << "    DRAM writes:     " << writes << std::endl;
+
+    if (verified)
+    {
+        stream << std::fixed << std::setprecision(3);
+        stream << "    Exact reads:     " << exact_reads << " (" << RelativeError(reads, exact_reads) << " % error)" << std::endl;
+        stream << "    Exact writes:    " << exact_writes << " (" << RelativeError(writes, exact_writes) << " % error)" << std::endl;
+    }
+
+    stream << std::fixed << std::setprecision(2);
+    stream << "    Wall time:       " << wall_seconds << " s" << std::endl;
+    stream << "    Throughput:      " << (wall_seconds > 0 ? accesses / wall_seconds / 1e6 : 0.0) << " M accesses/s" << std::endl;
+
+    stream.flags(flags);
+}
+
+std::string SliceRunner::SliceOutputFile(std::size_t slice) const
+{
+    return c_config.m_output_trace_file + ".slice" + std::to_string(slice);
+}
@@ -0,0 +1,387 @@
+/**
+ * @file      sweep_runner.cpp
+ * @brief     Sweep runner class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/sweep_runner.h>
+
+#include <utils/result_store.h>
+#include <utils/thread_pool.h>
+#include <utils/threading.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+    // Files and directories of a sweep.
+    constexpr char const* c_config_file = "sweep.conf";
+    constexpr char const* c_manifest_file = "manifest.tsv";
+    constexpr char const* c_claims_directory = "claims";
+    constexpr char const* c_results_directory = "results";
+    constexpr char const* c_outputs_directory = "outputs";
+
+    // Columns of a manifest line.
+    constexpr std::size_t c_manifest_columns = 7;
+
+    // Name of a job: its zero-padded index, so that listings sort in manifest order.
+    std::string JobName(std::size_t id)
+    {
+        std::ostringstream name;
+        name << std::setw(6) << std::setfill('0') << id;
+        return name.str();
+    }
+
+    // Name of the write policy in the manifest and the report.
+    char const* WritePolicyName(WritePolicy policy)
+    {
+        return policy == WritePolicy::WRITE_THROUGH ? "write_through" : "write_back";
+    }
+
+    // Worker process, as <host>:<pid>.
+    std::string GetWorkerName()
+    {
+        char host[256] = {};
+        if (gethostname(host, sizeof(host) - 1) != 0)
+            std::strcpy(host, "unknown");
+
+        return std::string(host) + ":" + std::to_string(getpid());
+    }
+
+    // Contents of a file. Empty if it cannot be read.
+    std::string ReadFile(std::filesystem::path const& file)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        std::ostringstream contents;
+
+        if (stream.is_open())
+            contents << stream.rdbuf();
+
+        return contents.str();
+    }
+
+    // Write a file aside and rename it into place, so that readers on any host see it whole or not at all.
+    void PublishFile(std::filesystem::path const& file, std::string const& contents)
+    {
+        std::filesystem::path const staging = file.parent_path() / ("." + file.filename().string() + "." + GetWorkerName());
+
+        {
+            std::ofstream stream(staging, std::ios::binary | std::ios::trunc);
+
+            if (!stream.write(contents.data(), contents.size()) || !stream.flush())
+                throw std::runtime_error("Could not write to sweep file " + staging.string());
+        }
+
+        std::filesystem::rename(staging, file);
+    }
+
+    // Fields of a result file, one "<name> <value>" per line.
+    std::map<std::string, std::string> ParseFields(std::string const& contents)
+    {
+        std::map<std::string, std::string> fields;
+        std::istringstream stream(contents);
+        std::string line;
+
+        while (std::getline(stream, line))
+        {
+            std::size_t const space = line.find(' ');
+            if (space != std::string::npos)
+                fields[line.substr(0, space)] = line.substr(space + 1);
+        }
+
+        return fields;
+    }
+}
+
+SweepRunner::SweepRunner(std::string const& directory, unsigned threads, bool pin_threads, std::string const& result_store)
+    : c_directory(directory), c_thread_count(ResolveThreadCount(threads)), c_pin_threads(pin_threads), c_result_store(result_store)
+{
+}
+
+std::size_t SweepRunner::Plan(std::string const& config_file, std::string const& directory)
+{
+    std::vector<Config> const points = ConfigReader::LoadSweep(config_file);
+    std::filesystem::path const root(directory);
+
+    // Replanning would renumber the jobs under the workers.
+    if (std::filesystem::exists(root / c_manifest_file))
+        throw std::invalid_argument("A sweep is already planned in " + directory + "; plan into a new directory.");
+
+    for (char const* const subdirectory : {c_claims_directory, c_results_directory, c_outputs_directory})
+        std::filesystem::create_directories(root / subdirectory);
+
+    std::filesystem::copy_file(config_file, root / c_config_file, std::filesystem::copy_options::overwrite_existing);
+
+    // Inputs are made absolute: workers run from any directory.
+    std::ostringstream manifest;
+    manifest << "# id\tinput\tsets\tways\tline_size\twrite_policy\twrite_allocate\n";
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        Config const& point = points[i];
+
+        manifest << JobName(i) << '\t' << std::filesystem::absolute(point.m_input_trace_file).lexically_normal().string() << '\t'
+                 << point.m_sets << '\t' << point.m_ways << '\t' << point.m_line_size << '\t'
+                 << WritePolicyName(point.m_write_policy) << '\t' << (point.m_write_allocate ? "true" : "false") << '\n';
+    }
+
+    // The manifest goes last: its presence marks a complete plan.
+    PublishFile(root / c_manifest_file, manifest.str());
+    return points.size();
+}
+
+std::vector<SweepJob> SweepRunner::ReadManifest(std::filesystem::path const& directory)
+{
+    std::filesystem::path const file = directory / c_manifest_file;
+    std::ifstream manifest(file);
+    if (!manifest.is_open())
+        throw std::invalid_argument("No sweep planned in " + directory.string() + " (missing " + c_manifest_file + ").");
+
+    std::vector<SweepJob> jobs;
+    std::string line;
+    std::size_t line_number = 0;
+
+    while (std::getline(manifest, line))
+    {
+        ++line_number;
+
+        // Skip blank lines and comments.
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<std::string> columns;
+        std::istringstream stream(line);
+        std::string column;
+
+        while (std::getline(stream, column, '\t'))
+            columns.push_back(column);
+
+        try
+        {
+            if (columns.size() != c_manifest_columns || (columns[5] != "write_back" && columns[5] != "write_through") ||
+                (columns[6] != "true" && columns[6] != "false"))
+                throw std::invalid_argument("bad columns");
+
+            SweepJob job;
+            job.m_id = std::stoul(columns[0]);
+            job.m_input_file = columns[1];
+            job.m_sets = std::stoul(columns[2]);
+            job.m_ways = std::stoul(columns[3]);
+            job.m_line_size = std::stoul(columns[4]);
+            job.m_write_policy = columns[5] == "write_through" ? WritePolicy::WRITE_THROUGH : WritePolicy::WRITE_BACK;
+            job.m_write_allocate = columns[6] == "true";
+
+            jobs.push_back(job);
+        }
+        catch (std::exception const&)
+        {
+            throw std::runtime_error("Invalid sweep manifest " + file.string() + ", line " + std::to_string(line_number) + ".");
+        }
+    }
+
+    return jobs;
+}
+
+std::size_t SweepRunner::Work()
+{
+    std::vector<SweepJob> const jobs = ReadManifest(c_directory);
+    Config const base = ConfigReader::Load((c_directory / c_config_file).string(), /* Require IO */ false);
+
+    std::unique_ptr<ResultStore> const store = c_result_store.empty() ? nullptr : std::make_unique<ResultStore>(c_result_store);
+
+    std::mutex progress_mutex;
+    std::size_t completed = 0;
+    std::vector<ThreadPool::Task> tasks;
+
+    // Every worker walks the manifest in order and skips the jobs claimed by others.
+    for (SweepJob const& job : jobs)
+    {
+        tasks.push_back([&, job](unsigned worker)
+        {
+            if (!Claim(job))
+                return;
+
+            Config config = base;
+            config.m_sets = job.m_sets;
+            config.m_ways = job.m_ways;
+            config.m_line_size = job.m_line_size;
+            config.m_write_policy = job.m_write_policy;
+            config.m_write_allocate = job.m_write_allocate;
+
+            BatchResult result;
+            result.m_input_file = job.m_input_file;
+            result.m_output_file = (c_directory / c_outputs_directory / (JobName(job.m_id) + ".trace")).string();
+            result.m_worker = worker;
+
+            BatchRunner::RunJob(config, result, store.get());
+            WriteResult(job, result);
+
+            // Report progress.
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            ++completed;
+            std::cout << "[" << JobName(job.m_id) << "] " << job.m_sets << "x" << job.m_ways << "x" << job.m_line_size << " "
+                      << WritePolicyName(job.m_write_policy) << (job.m_write_allocate ? "" : ", no-write-allocate") << " " << job.m_input_file
+                      << (result.m_error.empty() ? (result.m_reused ? " (stored)" : "") : " FAILED: " + result.m_error)
+                      << " (" << std::fixed << std::setprecision(2) << result.m_seconds << " s)" << std::defaultfloat << std::endl;
+        });
+    }
+
+    ThreadPool pool(c_thread_count, c_pin_threads);
+    pool.Run(std::move(tasks));
+
+    return completed;
+}
+
+bool SweepRunner::Claim(SweepJob const& job) const
+{
+    std::filesystem::path const claim = c_directory / c_claims_directory / JobName(job.m_id);
+
+    // Exactly one exclusive create of the claim succeeds, whatever the host.
+    int const fd = open(claim.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+    {
+        if (errno == EEXIST)
+            return false;
+
+        throw std::runtime_error("Could not claim sweep job " + claim.string() + ": " + std::strerror(errno));
+    }
+
+    // The owner is informative only: merges report it for jobs that never finished.
+    std::string const owner = GetWorkerName() + "\n";
+    bool const written = write(fd, owner.data(), owner.size()) == static_cast<ssize_t>(owner.size());
+    close(fd);
+
+    if (!written)
+        throw std::runtime_error("Could not write to sweep claim " + claim.string());
+
+    return true;
+}
+
+void SweepRunner::WriteResult(SweepJob const& job, BatchResult const& result) const
+{
+    std::ostringstream contents;
+    contents << "status " << (!result.m_error.empty() ? "failed" : result.m_reused ? "reused" : "ok") << "\n"
+             << "worker " << GetWorkerName() << "\n"
+             << "loads " << result.m_loads << "\n"
+             << "stores " << result.m_stores << "\n"
+             << "dram_reads " << result.m_dram_reads << "\n"
+             << "dram_writes " << result.m_dram_writes << "\n"
+             << "seconds " << result.m_seconds << "\n";
+
+    // Messages are kept on one line.
+    if (!result.m_error.empty())
+    {
+        std::string error = result.m_error;
+        for (char& character : error)
+            if (character == '\n')
+                character = ' ';
+
+        contents << "error " << error << "\n";
+    }
+
+    PublishFile(c_directory / c_results_directory / JobName(job.m_id), contents.str());
+}
+
+SweepSummary SweepRunner::Merge(std::string const& directory, std::string const& report_file, std::ostream& stream)
+{
+    std::filesystem::path const root(directory);
+    std::vector<SweepJob> const jobs = ReadManifest(root);
+
+    std::ofstream report(report_file, std::ios::trunc);
+    if (!report.is_open())
+        throw std::runtime_error("Could not write to output file " + report_file);
+
+    report << "id,input,sets,ways,line_size,write_policy,write_allocate,status,worker,loads,stores,dram_reads,dram_writes,miss_rate,seconds" << std::endl;
+
+    SweepSummary summary;
+    std::set<std::string> workers;
+    std::vector<std::string> failures;
+    std::uint64_t accesses = 0;
+    std::uint64_t dram_requests = 0;
+    double job_seconds = 0;
+
+    for (SweepJob const& job : jobs)
+    {
+        std::string const name = JobName(job.m_id);
+        std::map<std::string, std::string> fields = ParseFields(ReadFile(root / c_results_directory / name));
+        std::string status = fields["status"];
+        std::string worker = fields["worker"];
+
+        // Without a result, the claim tells a running (or crashed) job from a pending one.
+        if (status.empty())
+        {
+            std::string const owner = ReadFile(root / c_claims_directory / name);
+            bool const claimed = std::filesystem::exists(root / c_claims_directory / name);
+
+            status = claimed ? "running" : "pending";
+            worker = owner.substr(0, owner.find('\n'));
+        }
+
+        std::uint64_t const loads = fields.count("loads") ? std::stoull(fields["loads"]) : 0;
+        std::uint64_t const stores = fields.count("stores") ? std::stoull(fields["stores"]) : 0;
+        std::uint64_t const dram_reads = fields.count("dram_reads") ? std::stoull(fields["dram_reads"]) : 0;
+        std::uint64_t const dram_writes = fields.count("dram_writes") ? std::stoull(fields["dram_writes"]) : 0;
+        double const seconds = fields.count("seconds") ? std::stod(fields["seconds"]) : 0;
+
+        if (status == "failed")
+        {
+            ++summary.m_failed;
+            failures.push_back(name + ": " + fields["error"]);
+        }
+        else if (status == "running")
+            ++summary.m_running;
+        else if (status == "pending")
+            ++summary.m_pending;
+        else
+            ++summary.m_done;
+
+        if (!worker.empty())
+            workers.insert(worker);
+
+        accesses += loads + stores;
+        dram_requests += dram_reads + dram_writes;
+        job_seconds += seconds;
+
+        report << name << ',' << job.m_input_file << ',' << job.m_sets << ',' << job.m_ways << ',' << job.m_line_size << ','
+               << WritePolicyName(job.m_write_policy) << ',' << (job.m_write_allocate ? "true" : "false") << ',' << status << ',' << worker << ','
+               << loads << ',' << stores << ',' << dram_reads << ',' << dram_writes << ','
+               << (loads + stores ? static_cast<double>(dram_reads) / (loads + stores) : 0.0) << ',' << seconds << std::endl;
+    }
+
+    std::ios::fmtflags const flags = stream.flags();
+
+    stream << std::endl;
+    stream << "Sweep Summary:" << std::endl;
+    stream << "    Jobs:            " << jobs.size() << " (" << summary.m_done << " done, " << summary.m_failed << " failed, "
+           << summary.m_running << " running, " << summary.m_pending << " pending)" << std::endl;
+    stream << "    Workers:         " << workers.size() << std::endl;
+    stream << "    Accesses:        " << accesses << std::endl;
+    stream << "    DRAM requests:   " << dram_requests << std::endl;
+    stream << std::fixed << std::setprecision(2);
+    stream << "    Job time:        " << job_seconds << " s" << std::endl;
+
+    for (std::string const& failure : failures)
+        stream << "    FAILED:          " << failure << std::endl;
+
+    stream.flags(flags);
+    return summary;
+}
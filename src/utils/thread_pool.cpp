@@ -0,0 +1,105 @@
+/**
+ * @file      thread_pool.cpp
+ * @brief     Work-stealing thread pool class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/thread_pool.h>
+
+#include <utils/threading.h>
+
+#include <exception>
+#include <thread>
+
+ThreadPool::ThreadPool(unsigned threads, bool pin_threads) : c_thread_count(ResolveThreadCount(threads)), c_pin_threads(pin_threads)
+{
+    for (unsigned i = 0; i < c_thread_count; ++i)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+}
+
+void ThreadPool::Run(std::vector<Task> tasks)
+{
+    // Deal the tasks round-robin.
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+        m_queues[i % c_thread_count]->m_tasks.push_back(std::move(tasks[i]));
+
+    std::vector<unsigned> const cpus = GetAllowedCpus();
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+
+    auto worker_body = [&](unsigned worker)
+    {
+        if (c_pin_threads)
+            PinCurrentThread(cpus[worker % cpus.size()]);
+
+        Task task;
+        while (NextTask(worker, task))
+        {
+            try
+            {
+                task(worker);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!first_error)
+                    first_error = std::current_exception();
+            }
+        }
+    };
+
+    // The calling thread acts as worker 0.
+    std::vector<std::thread> workers;
+    for (unsigned worker = 1; worker < c_thread_count; ++worker)
+        workers.emplace_back(worker_body, worker);
+
+    worker_body(0);
+
+    // Give the calling thread its CPUs back: threads it starts later inherit its affinity.
+    if (c_pin_threads)
+        SetCurrentThreadCpus(cpus);
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    if (first_error)
+        std::rethrow_exception(first_error);
+}
+
+bool ThreadPool::NextTask(unsigned worker, Task& task)
+{
+    // Own queue first, front to back.
+    {
+        WorkerQueue& queue = *m_queues[worker];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+        if (!queue.m_tasks.empty())
+        {
+            task = std::move(queue.m_tasks.front());
+            queue.m_tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Steal from the back of the other queues. No task is ever added during a run, so empty queues stay empty.
+    for (unsigned i = 1; i < c_thread_count; ++i)
+    {
+        WorkerQueue& victim = *m_queues[(worker + i) % c_thread_count];
+        std::lock_guard<std::mutex> lock(victim.m_mutex);
+
+        if (!victim.m_tasks.empty())
+        {
+            task = std::move(victim.m_tasks.back());
+            victim.m_tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
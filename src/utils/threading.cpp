@@ -0,0 +1,76 @@
+/**
+ * @file      threading.cpp
+ * @brief     Thread placement helpers implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/threading.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+std::vector<unsigned> GetAllowedCpus()
+{
+    std::vector<unsigned> cpus;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &set))
+                cpus.push_back(cpu);
+    }
+#endif
+
+    // Fall back to every hardware thread.
+    if (cpus.empty())
+    {
+        unsigned const count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+bool PinCurrentThread(unsigned cpu)
+{
+    return SetCurrentThreadCpus({cpu});
+}
+
+bool SetCurrentThreadCpus(std::vector<unsigned> const& cpus)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (unsigned cpu : cpus)
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void) cpus;
+    return false;
+#endif
+}
+
+unsigned ResolveThreadCount(unsigned requested)
+{
+    if (requested != 0)
+        return requested;
+
+    return static_cast<unsigned>(GetAllowedCpus().size());
+}
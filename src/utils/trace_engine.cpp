@@ -13,43 +13,46 @@
 #include <utils/trace_engine.h>
 
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 
-// Define the static output file member.
-std::ofstream TraceEngine::m_output_file;
-
-// Define the static activity flag member.
-bool TraceEngine::m_is_active = false;
-
-// Define the static shutdown flag member.
-bool TraceEngine::m_is_shutdown = false;
-
-void TraceEngine::Initialize(std::string const& trace_file)
+TraceEngine::TraceEngine(std::string const& trace_file, bool quiet, TraceFormat format) :
+        c_format(format), m_is_active(false), m_is_shutdown(false), m_request_counts{0, 0, 0}
 {
-    // Check if already active or shutdown.
-    if (m_is_active)
-        throw std::runtime_error("TraceEngine is already initialized!");
-
-    if (m_is_shutdown)
-        throw std::runtime_error("Cannot initialize TraceEngine: it has already been shutdown!");
-
     // Warn if overwriting existing file.
-    if (std::filesystem::exists(trace_file))
+    if (!quiet && std::filesystem::exists(trace_file))
         std::cout << "Overwriting previous output trace: " << trace_file << std::endl;
 
+    // An output hard-linked to a stored result is unlinked first, so truncating it leaves the result intact.
+    std::error_code error;
+    if (std::filesystem::is_regular_file(trace_file, error) && std::filesystem::hard_link_count(trace_file, error) > 1)
+        std::filesystem::remove(trace_file, error);
+
     // Open the output file.
-    m_output_file.open(trace_file, std::ios::trunc); 
+    m_output_file.open(trace_file, std::ios::binary | std::ios::trunc);
 
     // Check if the file opened successfully.
     if (!m_output_file.is_open())
         throw std::runtime_error("Could not write to output file " + trace_file);
 
+    // Binary traces start with a header.
+    if (c_format == TraceFormat::BINARY)
+    {
+        trace_format::Header const header = {trace_format::c_magic, trace_format::c_version, sizeof(trace_format::Record)};
+        m_output_file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    }
+
     // Set active flag.
     m_is_active = true;
 }
 
-void TraceEngine::CheckActive()
+TraceEngine::~TraceEngine()
+{
+    // Destructor: Close the output file.
+    if (m_is_active)
+        Shutdown();
+}
+
+void TraceEngine::CheckActive() const
 {
     // Check if active.
     if (!m_is_active)
@@ -62,19 +65,42 @@ void TraceEngine::CheckActive()
     }
 }
 
-void TraceEngine::Load(address_t const address)
+void TraceEngine::Send(MemoryRequest const& request)
 {
-    // Log a load operation.
+    // Log the operation. Lines are not flushed individually; the stream is flushed on shutdown.
     CheckActive();
-    m_output_file << "LD 0x" << std::hex << address << std::dec << std::endl;
-}
+    ++m_request_counts[request.m_operation];
 
+    if (c_format == TraceFormat::BINARY)
+    {
+        trace_format::Record const record = {trace_format::Encode(request.m_operation, request.m_address), request.m_cycle};
+        m_output_file.write(reinterpret_cast<char const*>(&record), sizeof(record));
+        return;
+    }
 
-void TraceEngine::Store(address_t const address)
-{
-    // Log a store operation.
-    CheckActive();
-    m_output_file << "ST 0x" << std::hex << address << std::dec << std::endl;
+    if (c_format == TraceFormat::DRAMSIM3 || c_format == TraceFormat::DRAMSYS)
+    {
+        // DRAM simulators have no flush points.
+        if (request.m_operation == FLUSH)
+            return;
+
+        if (c_format == TraceFormat::DRAMSIM3)
+            m_output_file << "0x" << std::hex << request.m_address << std::dec << (request.m_operation == STORE ? " WRITE " : " READ ") << request.m_cycle << '\n';
+        else
+            m_output_file << request.m_cycle << (request.m_operation == STORE ? ":\twrite\t0x" : ":\tread\t0x") << std::hex << request.m_address << std::dec << '\n';
+
+        return;
+    }
+
+    if (request.m_operation == FLUSH)
+        m_output_file << "FLUSH";
+    else
+        m_output_file << (request.m_operation == STORE ? "ST 0x" : "LD 0x") << std::hex << request.m_address << std::dec;
+
+    if (c_format == TraceFormat::TIMED)
+        m_output_file << ' ' << request.m_cycle;
+
+    m_output_file << '\n';
 }
 
 void TraceEngine::Shutdown()
@@ -85,4 +111,4 @@ void TraceEngine::Shutdown()
     // Set the trace engine to inactive and shutdown.
     m_is_active = false;
     m_is_shutdown = true;
-}
\ No newline at end of file
+}
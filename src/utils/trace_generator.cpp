@@ -0,0 +1,417 @@
+/**
+ * @file      trace_generator.cpp
+ * @brief     Synthetic trace generator class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/trace_generator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+    // Wide product for the modular scattering of Zipfian ranks.
+    __extension__ typedef unsigned __int128 uint128_t;
+
+    // Records formatted per buffer by each writer thread.
+    constexpr std::uint64_t c_records_per_chunk = 1 << 16;
+
+    // Independent random streams derived from the seed.
+    constexpr std::uint64_t c_stream_operation = 0x6f70;
+    constexpr std::uint64_t c_stream_address   = 0x6164;
+    constexpr std::uint64_t c_stream_offset    = 0x6f66;
+
+    // Counter-based random number: a SplitMix64 finalizer over (seed, stream, index).
+    // Every access can be generated independently, so the output does not depend on the thread count.
+    inline std::uint64_t Mix64(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+    {
+        std::uint64_t z = seed * 0x9E3779B97F4A7C15ull + stream * 0xD1B54A32D192ED03ull + index;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Map a 64-bit random number to [0, range) with a multiply instead of a division (Lemire).
+    inline std::uint64_t Reduce(std::uint64_t random, std::uint64_t range)
+    {
+        return static_cast<std::uint64_t>((static_cast<uint128_t>(random) * range) >> 64);
+    }
+
+    // Terms of the Zipfian normalization summed exactly. Larger footprints approximate the rest.
+    constexpr std::uint64_t c_zeta_exact_terms = 1 << 16;
+
+    // Generalized harmonic number zeta(n, theta) = sum of 1 / i^theta for i in [1, n]. Past the first terms, the
+    // sum is replaced by its Euler-Maclaurin integral approximation, so the cost does not grow with the footprint.
+    double Zeta(std::uint64_t n, double theta)
+    {
+        std::uint64_t const exact_terms = std::min(n, c_zeta_exact_terms);
+
+        double zeta = 0;
+        for (std::uint64_t i = 1; i <= exact_terms; ++i)
+            zeta += 1.0 / std::pow(static_cast<double>(i), theta);
+
+        if (n == exact_terms)
+            return zeta;
+
+        // Sum over [m, n] of f(x) = x^-theta, minus f(m) which is already counted:
+        // integral + (f(m) + f(n)) / 2 + (f'(n) - f'(m)) / 12.
+        double const m = static_cast<double>(exact_terms);
+        double const last = static_cast<double>(n);
+        auto f = [theta](double x) { return std::pow(x, -theta); };
+        auto derivative = [theta](double x) { return -theta * std::pow(x, -theta - 1.0); };
+
+        double const integral = (std::pow(last, 1.0 - theta) - std::pow(m, 1.0 - theta)) / (1.0 - theta);
+        return zeta - f(m) + integral + (f(m) + f(last)) / 2.0 + (derivative(last) - derivative(m)) / 12.0;
+    }
+
+    // Offset modulo a size, avoiding the division for powers of 2.
+    inline std::uint64_t Wrap(std::uint64_t offset, std::uint64_t size)
+    {
+        return IsPow2(size) ? (offset & (size - 1)) : (offset % size);
+    }
+
+    // Spread the 8 nibbles of a 32-bit value into 8 lowercase hexadecimal characters, most significant first.
+    inline std::uint64_t HexWord(std::uint32_t value)
+    {
+        std::uint64_t x = value;
+        x = ((x << 16) | x) & 0x0000FFFF0000FFFFull;
+        x = ((x << 8) | x) & 0x00FF00FF00FF00FFull;
+        x = ((x << 4) | x) & 0x0F0F0F0F0F0F0F0Full;
+
+        // Nibbles above 9 map to 'a'-'f'.
+        std::uint64_t const letters = ((x + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+        x += 0x3030303030303030ull + letters * ('a' - '0' - 10);
+
+        // The most significant nibble ended up in the lowest byte: reverse for little-endian stores.
+        return __builtin_bswap64(x);
+    }
+
+    // Uniform random value in [0, 1) from a 64-bit random number.
+    inline double ToUnit(std::uint64_t random)
+    {
+        return static_cast<double>(random >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Sum of the phase lengths.
+    std::uint64_t CycleLength(std::vector<GeneratorPhase> const& phases)
+    {
+        std::uint64_t length = 0;
+        for (GeneratorPhase const& phase : phases)
+            length += phase.m_length;
+
+        return length;
+    }
+}
+
+TraceGenerator::TraceGenerator(GeneratorConfig const& config) :
+        c_config(config),
+        c_footprint_lines(config.m_line_size ? config.m_footprint / config.m_line_size : 0),
+        c_cycle_length(CycleLength(config.m_phases)),
+        c_write_threshold(config.m_write_ratio >= 1.0 ? std::numeric_limits<std::uint64_t>::max() : static_cast<std::uint64_t>(config.m_write_ratio * 18446744073709551616.0)),
+        m_zipf_zetan(0),
+        m_zipf_alpha(0),
+        m_zipf_eta(0),
+        m_zipf_scatter(1)
+{
+    // Validate parameters.
+    if (c_config.m_phases.empty())
+        throw std::invalid_argument("Trace generator requires at least one phase.");
+
+    for (GeneratorPhase const& phase : c_config.m_phases)
+        if (phase.m_length == 0)
+            throw std::invalid_argument("Trace generator phases must have a length greater than 0.");
+
+    if (!IsPow2(c_config.m_line_size))
+        throw std::invalid_argument("Trace generator line size must be a power of 2.");
+
+    if (c_footprint_lines == 0)
+        throw std::invalid_argument("Trace generator footprint must be at least one line.");
+
+    if (c_config.m_element_size == 0 || c_config.m_stride == 0)
+        throw std::invalid_argument("Trace generator element size and stride must be greater than 0.");
+
+    if (c_config.m_element_size > c_config.m_line_size)
+        throw std::invalid_argument("Trace generator element size cannot exceed the line size.");
+
+    if (c_config.m_write_ratio < 0.0 || c_config.m_write_ratio > 1.0)
+        throw std::invalid_argument("Trace generator write ratio must be in [0, 1].");
+
+    if (c_config.m_address_digits == 0 || c_config.m_address_digits > 16)
+        throw std::invalid_argument("Trace generator address digits must be in [1, 16].");
+
+    address_t const last_address = c_config.m_base_address + c_config.m_footprint - 1;
+    if (last_address < c_config.m_base_address || (c_config.m_address_digits < 16 && (last_address >> (4 * c_config.m_address_digits)) != 0))
+        throw std::invalid_argument("Trace generator footprint does not fit in the configured address digits.");
+
+    // Phase start offsets within a cycle.
+    std::uint64_t start = 0;
+    for (GeneratorPhase const& phase : c_config.m_phases)
+    {
+        m_phase_starts.push_back(start);
+        start += phase.m_length;
+    }
+
+    auto uses = [&](AccessPattern pattern)
+    {
+        return std::any_of(c_config.m_phases.begin(), c_config.m_phases.end(), [&](GeneratorPhase const& phase) { return phase.m_pattern == pattern; });
+    };
+
+    // Zipfian constants (Gray et al., "Quickly Generating Billion-Record Synthetic Databases").
+    if (uses(AccessPattern::ZIPFIAN))
+    {
+        double const theta = c_config.m_zipf_theta;
+        if (theta <= 0.0 || theta >= 1.0)
+            throw std::invalid_argument("Trace generator Zipfian theta must be in (0, 1).");
+
+        double const n = static_cast<double>(c_footprint_lines);
+        double zeta2 = 1.0 + std::pow(0.5, theta);
+
+        m_zipf_zetan = Zeta(c_footprint_lines, theta);
+
+        m_zipf_alpha = 1.0 / (1.0 - theta);
+        m_zipf_eta = (1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / m_zipf_zetan);
+
+        // Pick a multiplier coprime with the footprint so that popular lines are spread out.
+        m_zipf_scatter = 0x9E3779B97F4A7C15ull % c_footprint_lines;
+        while (c_footprint_lines > 1 && std::gcd(m_zipf_scatter, c_footprint_lines) != 1)
+            ++m_zipf_scatter;
+    }
+
+    // The pointer chase visits every line of the footprint once per lap, in a random order.
+    if (uses(AccessPattern::POINTER_CHASE))
+    {
+        if (c_footprint_lines > std::numeric_limits<std::uint32_t>::max())
+            throw std::invalid_argument("Trace generator pointer-chase footprint is too large.");
+
+        m_chase_order.resize(c_footprint_lines);
+        std::iota(m_chase_order.begin(), m_chase_order.end(), 0);
+
+        // Fisher-Yates shuffle.
+        for (std::uint64_t i = c_footprint_lines - 1; i > 0; --i)
+            std::swap(m_chase_order[i], m_chase_order[Mix64(c_config.m_seed, c_stream_address, i) % (i + 1)]);
+    }
+}
+
+void TraceGenerator::GetAccess(std::uint64_t index, Operation& op_type, address_t& address) const
+{
+    op_type = (Mix64(c_config.m_seed, c_stream_operation, index) < c_write_threshold) ? STORE : LOAD;
+
+    // Pure patterns need no phase lookup.
+    if (m_phase_starts.size() == 1)
+    {
+        address = PatternAddress(c_config.m_phases[0].m_pattern, index);
+        return;
+    }
+
+    // Locate the phase and the index within the pattern. Patterns resume where they left off in the previous cycle.
+    std::uint64_t const cycle = index / c_cycle_length;
+    std::uint64_t const position = index % c_cycle_length;
+
+    std::size_t phase = m_phase_starts.size() - 1;
+    while (m_phase_starts[phase] > position)
+        --phase;
+
+    GeneratorPhase const& current = c_config.m_phases[phase];
+    std::uint64_t const pattern_index = cycle * current.m_length + (position - m_phase_starts[phase]);
+
+    address = PatternAddress(current.m_pattern, pattern_index);
+}
+
+address_t TraceGenerator::PatternAddress(AccessPattern pattern, std::uint64_t index) const
+{
+    address_t const base = c_config.m_base_address;
+    std::uint64_t const footprint = c_footprint_lines * c_config.m_line_size;
+
+    switch (pattern)
+    {
+        case AccessPattern::STREAMING:
+            return base + Wrap(index * c_config.m_element_size, footprint);
+
+        case AccessPattern::STRIDED:
+            return base + Wrap(index * c_config.m_stride, footprint);
+
+        case AccessPattern::RANDOM:
+        {
+            std::uint64_t const random = Mix64(c_config.m_seed, c_stream_address, index);
+            return base + Reduce(random, footprint / c_config.m_element_size) * c_config.m_element_size;
+        }
+
+        case AccessPattern::ZIPFIAN:
+        {
+            std::uint64_t const rank = ZipfRank(Mix64(c_config.m_seed, c_stream_address, index));
+            std::uint64_t const line = static_cast<std::uint64_t>((static_cast<uint128_t>(rank) * m_zipf_scatter) % c_footprint_lines);
+            std::uint64_t const offset = Mix64(c_config.m_seed, c_stream_offset, index) & (c_config.m_line_size - 1);
+            return base + line * c_config.m_line_size + (offset / c_config.m_element_size) * c_config.m_element_size;
+        }
+
+        case AccessPattern::POINTER_CHASE:
+            return base + static_cast<address_t>(m_chase_order[Wrap(index, c_footprint_lines)]) * c_config.m_line_size;
+    }
+
+    throw std::invalid_argument("Unknown access pattern.");
+}
+
+std::uint64_t TraceGenerator::ZipfRank(std::uint64_t random) const
+{
+    double const u = ToUnit(random);
+    double const uz = u * m_zipf_zetan;
+
+    if (uz < 1.0)
+        return 0;
+
+    if (uz < 1.0 + std::pow(0.5, c_config.m_zipf_theta))
+        return std::min<std::uint64_t>(1, c_footprint_lines - 1);
+
+    std::uint64_t const rank = static_cast<std::uint64_t>(static_cast<double>(c_footprint_lines) * std::pow(m_zipf_eta * u - m_zipf_eta + 1.0, m_zipf_alpha));
+    return std::min(rank, c_footprint_lines - 1);
+}
+
+std::size_t TraceGenerator::GetRecordSize() const
+{
+    // "LD 0x" + address + '\n'.
+    return 6 + c_config.m_address_digits;
+}
+
+void TraceGenerator::Format(std::uint64_t begin, std::uint64_t end, char* buffer) const
+{
+    unsigned const digits = c_config.m_address_digits;
+    std::size_t const record_size = GetRecordSize();
+
+    // Records are assembled in a local buffer so that the stores do not alias the generator state.
+    // The address is always rendered with 16 digits in record[16, 32) and the leading ones are skipped.
+    char record[32] = {};
+    char* const line = record + 32 - digits - 5;
+
+    Operation op_type;
+    address_t address;
+
+    for (std::uint64_t index = begin; index < end; ++index)
+    {
+        GetAccess(index, op_type, address);
+
+        std::uint64_t const high = HexWord(static_cast<std::uint32_t>(address >> 32));
+        std::uint64_t const low = HexWord(static_cast<std::uint32_t>(address));
+        std::memcpy(record + 16, &high, sizeof(high));
+        std::memcpy(record + 24, &low, sizeof(low));
+
+        line[0] = (op_type == STORE) ? 'S' : 'L';
+        line[1] = (op_type == STORE) ? 'T' : 'D';
+        line[2] = ' ';
+        line[3] = '0';
+        line[4] = 'x';
+
+        std::memcpy(buffer, line, record_size - 1);
+        buffer[record_size - 1] = '\n';
+        buffer += record_size;
+    }
+}
+
+std::uint64_t TraceGenerator::Write(std::string const& filename) const
+{
+    std::size_t const record_size = GetRecordSize();
+    std::uint64_t const total_size = c_config.m_accesses * record_size;
+
+    // Open and size the output file so that every thread can write its own region.
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        throw std::runtime_error("Could not write to output file " + filename);
+
+    if (ftruncate(fd, static_cast<off_t>(total_size)) == -1)
+    {
+        close(fd);
+        throw std::runtime_error("Could not resize output file " + filename);
+    }
+
+    unsigned thread_count = c_config.m_threads ? c_config.m_threads : std::max(1u, std::thread::hardware_concurrency());
+    thread_count = static_cast<unsigned>(std::min<std::uint64_t>(thread_count, std::max<std::uint64_t>(1, c_config.m_accesses / c_records_per_chunk)));
+
+    std::vector<std::thread> workers;
+    std::atomic<bool> failed(false);
+
+    // Each thread formats a contiguous range of records, chunk by chunk.
+    for (unsigned t = 0; t < thread_count; ++t)
+    {
+        workers.emplace_back([&, t]()
+        {
+            std::uint64_t const begin = c_config.m_accesses * t / thread_count;
+            std::uint64_t const end = c_config.m_accesses * (t + 1) / thread_count;
+            std::vector<char> buffer(c_records_per_chunk * record_size);
+
+            for (std::uint64_t chunk = begin; chunk < end && !failed; chunk += c_records_per_chunk)
+            {
+                std::uint64_t const chunk_end = std::min(end, chunk + c_records_per_chunk);
+                Format(chunk, chunk_end, buffer.data());
+
+                // Write the chunk at its final position.
+                std::size_t const bytes = (chunk_end - chunk) * record_size;
+                std::size_t written = 0;
+                while (written < bytes)
+                {
+                    ssize_t const result = pwrite(fd, buffer.data() + written, bytes - written, static_cast<off_t>(chunk * record_size + written));
+                    if (result <= 0)
+                    {
+                        failed = true;
+                        break;
+                    }
+
+                    written += static_cast<std::size_t>(result);
+                }
+            }
+        });
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    close(fd);
+
+    if (failed)
+        throw std::runtime_error("Error while writing output file " + filename);
+
+    return total_size;
+}
+
+AccessPattern TraceGenerator::ParsePattern(std::string const& name)
+{
+    if (name == "streaming" || name == "stream")
+        return AccessPattern::STREAMING;
+    if (name == "strided" || name == "stride")
+        return AccessPattern::STRIDED;
+    if (name == "random" || name == "uniform")
+        return AccessPattern::RANDOM;
+    if (name == "zipfian" || name == "zipf")
+        return AccessPattern::ZIPFIAN;
+    if (name == "pointer_chase" || name == "chase")
+        return AccessPattern::POINTER_CHASE;
+
+    throw std::invalid_argument("Unknown access pattern '" + name + "'.");
+}
+
+char const* TraceGenerator::PatternName(AccessPattern pattern)
+{
+    switch (pattern)
+    {
+        case AccessPattern::STREAMING:     return "streaming";
+        case AccessPattern::STRIDED:       return "strided";
+        case AccessPattern::RANDOM:        return "random";
+        case AccessPattern::ZIPFIAN:       return "zipfian";
+        case AccessPattern::POINTER_CHASE: return "pointer_chase";
+    }
+
+    return "unknown";
+}
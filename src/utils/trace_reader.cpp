@@ -12,8 +12,11 @@
 
 #include <utils/trace_reader.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fcntl.h>
 #include <iostream>
+#include <stdexcept>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -57,7 +60,9 @@ uint8_t TraceReader::c_hex_lookup[256] =
 };
 
 
-TraceReader::TraceReader(const std::string& filename) : m_cursor(0), m_fd(-1), m_data(nullptr), m_file_size(0)
+TraceReader::TraceReader(const std::string& filename) :
+        m_cursor(0), m_end(0), m_binary(false), m_data_begin(0), m_timestamp(TIMESTAMP_MAX),
+        m_filtering(false), m_filtered_count(0), m_fd(-1), m_data(nullptr), m_file_size(0)
 {
     // Open file descriptor.
     m_fd = open(filename.c_str(), O_RDONLY);
@@ -71,6 +76,7 @@ TraceReader::TraceReader(const std::string& filename) : m_cursor(0), m_fd(-1), m
         throw std::runtime_error("Error: Could not get file size for " + filename);
 
     m_file_size = sb.st_size;
+    m_end = m_file_size;
 
     // Memory Map the file.
     // PROT_READ: We only need to read.
@@ -82,6 +88,26 @@ TraceReader::TraceReader(const std::string& filename) : m_cursor(0), m_fd(-1), m
     
     // Use madvise to tell OS we will read sequentially (triggers aggressive pre-fetching)
     madvise(m_data, m_file_size, MADV_SEQUENTIAL);
+
+    // Binary traces start with a header.
+    trace_format::Header header = {};
+    if (m_file_size >= sizeof(header))
+    {
+        std::memcpy(&header, m_data, sizeof(header));
+        m_binary = header.m_magic == trace_format::c_magic;
+    }
+
+    if (m_binary)
+    {
+        if (header.m_version != trace_format::c_version || header.m_record_size != sizeof(trace_format::Record))
+            throw std::runtime_error("TraceReader Error: Unsupported binary trace version in " + filename);
+
+        if ((m_file_size - sizeof(header)) % sizeof(trace_format::Record) != 0)
+            throw std::runtime_error("TraceReader Error: Truncated binary trace " + filename);
+
+        m_data_begin = sizeof(header);
+        m_cursor = m_data_begin;
+    }
 }
 
 TraceReader::~TraceReader()
@@ -97,8 +123,26 @@ TraceReader::~TraceReader()
 
 bool TraceReader::GetNextAccess(Operation& op_type, address_t& address)
 {
+    if (m_binary)
+    {
+        if (m_cursor >= m_end)
+            return false;
+
+        trace_format::Record record;
+        std::memcpy(&record, m_data + m_cursor, sizeof(record));
+        m_cursor += sizeof(record);
+
+        // Markers are skipped.
+        if (trace_format::IsMarker(record.m_word))
+            return GetNextAccess(op_type, address);
+
+        trace_format::Decode(record.m_word, op_type, address);
+        m_timestamp = record.m_timestamp;
+        return true;
+    }
+
     // Check for end of file after reading operation type and whitespace.
-    if (m_cursor + 3 >= m_file_size) return false;
+    if (m_cursor + 3 >= m_end) return false;
 
     // Read operation type. 
     char const op_type_char[2] = {m_data[m_cursor++], m_data[m_cursor++]};
@@ -106,6 +150,37 @@ bool TraceReader::GetNextAccess(Operation& op_type, address_t& address)
         op_type = LOAD;
     else if (op_type_char[0] == 'S' && op_type_char[1] == 'T')
         op_type = STORE;
+    else if (op_type_char[0] == 'F' && op_type_char[1] == 'L')
+    {
+        // Flush marker: a line with just "FLUSH".
+        if (m_cursor + 3 > m_end || std::memcmp(m_data + m_cursor, "USH", 3) != 0)
+            throw std::runtime_error("TraceReader Error: Unknown marker in trace file, expected FLUSH.");
+
+        m_cursor += 3;
+        char character = m_cursor < m_end ? m_data[m_cursor++] : '\n';
+
+        if (character == ' ')
+        {
+            // Timestamp column.
+            m_timestamp = 0;
+
+            while (m_cursor < m_end && (character = m_data[m_cursor++]) >= '0' && character <= '9')
+                m_timestamp = m_timestamp * 10 + (character - '0');
+        }
+
+        if (character != '\n' && m_cursor < m_end)
+            throw std::runtime_error("TraceReader Error: Expected newline after FLUSH!");
+
+        op_type = FLUSH;
+        address = 0;
+        return true;
+    }
+    else if (op_type_char[0] == 'R' && op_type_char[1] == 'O')
+    {
+        // Region-of-interest marker: skipped, the region is located by FindRegion.
+        SkipMarker();
+        return GetNextAccess(op_type, address);
+    }
     else
         throw std::runtime_error("TraceReader Error: Unknown operation type '" + std::string(op_type_char, 2) + "' in trace file.");
     
@@ -114,15 +189,15 @@ bool TraceReader::GetNextAccess(Operation& op_type, address_t& address)
         throw std::runtime_error("TraceReader Error: Expected whitespace after operation type!");
 
     // Skip "0x" if present.
-    if (m_cursor + 1 < m_file_size && (m_data[m_cursor + 1] == 'x' || m_data[m_cursor + 1] == 'X'))
+    if (m_cursor + 1 < m_end && (m_data[m_cursor + 1] == 'x' || m_data[m_cursor + 1] == 'X'))
         m_cursor += 2;
 
     // Initialize address to zero.
     address = 0;
     
     // Read hexadecimal address.
-    char character;
-    while (m_cursor < m_file_size)
+    char character = 0;
+    while (m_cursor < m_end)
     {
         // Read the next character.
         character = m_data[m_cursor++];
@@ -137,8 +212,247 @@ bool TraceReader::GetNextAccess(Operation& op_type, address_t& address)
         address = (address << 4) | val;
     }
 
-    if (character != '\n' && character != '\r' && m_cursor < m_file_size)
+    if (character == ' ')
+    {
+        // Timestamp column.
+        m_timestamp = 0;
+
+        while (m_cursor < m_end && (character = m_data[m_cursor++]) >= '0' && character <= '9')
+            m_timestamp = m_timestamp * 10 + (character - '0');
+    }
+
+    if (character != '\n' && character != '\r' && m_cursor < m_end)
         throw std::runtime_error("TraceReader Error: Expected newline after address!");
 
     return true;
-}
\ No newline at end of file
+}
+
+bool TraceReader::GetNextTimedAccess(Operation& op_type, address_t& address, timestamp_t& timestamp)
+{
+    // Only timestamp columns and binary records set the timestamp.
+    m_timestamp = TIMESTAMP_MAX;
+
+    if (!GetNextAccess(op_type, address))
+        return false;
+
+    timestamp = m_timestamp;
+    return true;
+}
+
+std::size_t TraceReader::GetNextAccesses(MemoryAccess* accesses, std::size_t max_count)
+{
+    std::size_t count = 0;
+
+    if (m_binary)
+    {
+        // Decode the records directly. Markers and filtered accesses are overwritten by the next record.
+        std::size_t records;
+
+        while (count == 0 && (records = std::min(max_count, (m_end - m_cursor) / sizeof(trace_format::Record))) != 0)
+        {
+            for (std::size_t i = 0; i < records; ++i)
+            {
+                trace_format::Record record;
+                std::memcpy(&record, m_data + m_cursor + i * sizeof(record), sizeof(record));
+                trace_format::Decode(record.m_word, accesses[count].m_operation, accesses[count].m_address);
+                accesses[count].m_timestamp = record.m_timestamp;
+                count += !trace_format::IsMarker(record.m_word) && Keep(accesses[count]);
+            }
+
+            m_cursor += records * sizeof(trace_format::Record);
+        }
+
+        return count;
+    }
+
+    while (count < max_count)
+    {
+        // Only timestamp columns set the timestamp.
+        m_timestamp = TIMESTAMP_MAX;
+
+        if (!GetNextAccess(accesses[count].m_operation, accesses[count].m_address))
+            break;
+
+        accesses[count].m_timestamp = m_timestamp;
+        count += Keep(accesses[count]);
+    }
+
+    return count;
+}
+
+void TraceReader::SetFilter(std::vector<AddressRange> const& include, std::vector<AddressRange> const& exclude)
+{
+    m_include_ranges = include;
+    m_exclude_ranges = exclude;
+    m_filtering = !include.empty() || !exclude.empty();
+}
+
+TraceRegion TraceReader::FindRegion(bool roi, std::uint64_t skip, std::uint64_t warmup, std::uint64_t measure) const
+{
+    std::size_t origin = m_data_begin;
+    std::size_t end = m_file_size;
+
+    if (roi)
+    {
+        // The region of interest starts past its marker and ends at the next ROI_END.
+        std::size_t const marker = FindMarker(m_data_begin, /* Begin */ true);
+        if (marker == m_file_size)
+            throw std::runtime_error("TraceReader Error: No ROI_BEGIN marker in the trace.");
+
+        origin = AdvanceLines(marker, 1);
+        end = FindMarker(origin, /* Begin */ false);
+    }
+
+    // Without markers, the warmup is part of the accesses before the measurement.
+    TraceRegion region;
+    region.m_measure_begin = std::min(AdvanceLines(origin, roi ? skip : skip + warmup), end);
+    region.m_warmup_begin = RewindLines(region.m_measure_begin, warmup);
+    region.m_measure_end = measure != 0 ? std::min(AdvanceLines(region.m_measure_begin, measure), end) : end;
+
+    return region;
+}
+
+std::size_t TraceReader::FindMarker(std::size_t offset, bool begin) const
+{
+    if (m_binary)
+    {
+        std::uint64_t const marker = begin ? trace_format::c_roi_begin_word : trace_format::c_roi_end_word;
+
+        for (; offset + sizeof(trace_format::Record) <= m_file_size; offset += sizeof(trace_format::Record))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, m_data + offset, sizeof(word));
+
+            if (word == marker)
+                return offset;
+        }
+
+        return m_file_size;
+    }
+
+    char const* const marker = begin ? "ROI_BEGIN" : "ROI_END";
+    std::size_t const length = std::strlen(marker);
+
+    while (offset < m_file_size)
+    {
+        void const* const found = memmem(m_data + offset, m_file_size - offset, marker, length);
+        if (found == nullptr)
+            return m_file_size;
+
+        // Only a whole line is a marker.
+        std::size_t const position = static_cast<char const*>(found) - m_data;
+        char const next = position + length < m_file_size ? m_data[position + length] : '\n';
+
+        if ((position == m_data_begin || m_data[position - 1] == '\n') && (next == '\n' || next == '\r' || next == ' '))
+            return position;
+
+        offset = position + length;
+    }
+
+    return m_file_size;
+}
+
+void TraceReader::SkipMarker()
+{
+    if (m_cursor + 5 <= m_end && std::memcmp(m_data + m_cursor, "I_END", 5) == 0)
+        m_cursor += 5;
+    else if (m_cursor + 7 <= m_end && std::memcmp(m_data + m_cursor, "I_BEGIN", 7) == 0)
+        m_cursor += 7;
+    else
+        throw std::runtime_error("TraceReader Error: Unknown marker in trace file, expected ROI_BEGIN or ROI_END.");
+
+    // Step past the rest of the line (a timestamp column).
+    void const* const newline = m_cursor < m_end ? std::memchr(m_data + m_cursor, '\n', m_end - m_cursor) : nullptr;
+    m_cursor = newline ? static_cast<char const*>(newline) - m_data + 1 : m_end;
+}
+
+void TraceReader::SetRange(std::size_t begin, std::size_t end)
+{
+    if (begin < m_data_begin || begin > end || end > m_file_size)
+        throw std::out_of_range("TraceReader Error: Invalid range.");
+
+    m_cursor = begin;
+    m_end = end;
+}
+
+std::vector<std::size_t> TraceReader::GetSliceOffsets(std::size_t slices) const
+{
+    return GetSliceOffsets(slices, m_data_begin, m_file_size);
+}
+
+std::vector<std::size_t> TraceReader::GetSliceOffsets(std::size_t slices, std::size_t begin, std::size_t end) const
+{
+    if (slices == 0)
+        throw std::invalid_argument("TraceReader Error: At least one slice is needed.");
+
+    std::vector<std::size_t> offsets(slices + 1, end);
+    offsets[0] = begin;
+
+    for (std::size_t i = 1; i < slices; ++i)
+    {
+        if (m_binary)
+        {
+            // Round the even cut down to a record.
+            std::size_t const records = (end - begin) / sizeof(trace_format::Record);
+            offsets[i] = begin + records * i / slices * sizeof(trace_format::Record);
+            continue;
+        }
+
+        // Move the even cut to the start of the next line. Never go back past the previous cut.
+        std::size_t const cut = std::max(offsets[i - 1], begin + (end - begin) / slices * i);
+        void const* newline = cut < end ? std::memchr(m_data + cut, '\n', end - cut) : nullptr;
+
+        offsets[i] = newline ? static_cast<char const*>(newline) - m_data + 1 : end;
+    }
+
+    return offsets;
+}
+
+std::size_t TraceReader::RewindLines(std::size_t offset, std::size_t lines) const
+{
+    if (m_binary)
+        return offset - std::min<std::size_t>(lines, (offset - m_data_begin) / sizeof(trace_format::Record)) * sizeof(trace_format::Record);
+
+    for (std::size_t i = 0; i < lines && offset > 0; ++i)
+    {
+        // Step onto the newline that ends the previous line, then back to its start.
+        --offset;
+        while (offset > 0 && m_data[offset - 1] != '\n')
+            --offset;
+    }
+
+    return offset;
+}
+
+std::size_t TraceReader::AdvanceLines(std::size_t offset, std::size_t lines) const
+{
+    if (m_binary)
+        return offset + std::min<std::size_t>(lines, (m_file_size - offset) / sizeof(trace_format::Record)) * sizeof(trace_format::Record);
+
+    for (std::size_t i = 0; i < lines && offset < m_file_size; ++i)
+    {
+        // Step past the newline that ends the line.
+        void const* newline = std::memchr(m_data + offset, '\n', m_file_size - offset);
+        offset = newline ? static_cast<char const*>(newline) - m_data + 1 : m_file_size;
+    }
+
+    return offset;
+}
+
+std::size_t TraceReader::CountLines(std::size_t begin, std::size_t end) const
+{
+    if (m_binary)
+        return (end - begin) / sizeof(trace_format::Record);
+
+    std::size_t lines = 0;
+
+    while (begin < end)
+    {
+        // A last line without a newline still counts.
+        void const* newline = std::memchr(m_data + begin, '\n', end - begin);
+        begin = newline ? static_cast<char const*>(newline) - m_data + 1 : end;
+        ++lines;
+    }
+
+    return lines;
+}
@@ -0,0 +1,559 @@
+/**
+ * @file      trace_toolkit.cpp
+ * @brief     Trace toolkit class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/trace_toolkit.h>
+
+#include <utils/thread_pool.h>
+#include <utils/threading.h>
+#include <utils/trace_engine.h>
+#include <utils/trace_reader.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace
+{
+    // Temporary output of one worker.
+    std::string PartFile(std::string const& output, std::size_t part)
+    {
+        return output + ".part" + std::to_string(part);
+    }
+
+    // Concatenate the worker outputs in order and remove them. Binary parts after the first lose their header.
+    void ConcatenateParts(std::string const& output, std::size_t parts, TraceFormat format)
+    {
+        std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+            throw std::runtime_error("Could not write to output file " + output);
+
+        for (std::size_t i = 0; i < parts; ++i)
+        {
+            std::ifstream part(PartFile(output, i), std::ios::binary);
+
+            if (i != 0 && format == TraceFormat::BINARY)
+                part.seekg(sizeof(trace_format::Header));
+
+            // An empty stream buffer sets failbit on the output; empty parts are expected.
+            if (part.peek() != std::ifstream::traits_type::eof())
+                stream << part.rdbuf();
+
+            part.close();
+            std::filesystem::remove(PartFile(output, i));
+        }
+
+        if (!stream.flush())
+            throw std::runtime_error("Could not write to output file " + output);
+    }
+
+    // Remove the worker outputs after a failure.
+    void RemoveParts(std::string const& output, std::size_t parts)
+    {
+        for (std::size_t i = 0; i < parts; ++i)
+            std::filesystem::remove(PartFile(output, i));
+    }
+
+    // Log2 of a power of two, validated.
+    unsigned CheckedShift(std::uint64_t size, char const* what)
+    {
+        if (!IsPow2(size))
+            throw std::invalid_argument(std::string(what) + " must be a power of 2.");
+
+        return static_cast<unsigned>(__builtin_ctzll(size));
+    }
+
+    // Stride bucket of a distance in lines.
+    std::size_t StrideBucket(std::uint64_t magnitude)
+    {
+        return magnitude == 0 ? 0 : 64 - __builtin_clzll(magnitude);
+    }
+}
+
+TraceToolkit::TraceToolkit(unsigned threads) : c_thread_count(ResolveThreadCount(threads))
+{
+}
+
+TraceFormat TraceToolkit::DetectFormat(std::string const& input)
+{
+    TraceReader reader(input);
+
+    if (reader.GetFormat() == TraceFormat::BINARY)
+        return TraceFormat::BINARY;
+
+    Operation operation;
+    address_t address;
+    timestamp_t timestamp;
+
+    if (reader.GetNextTimedAccess(operation, address, timestamp) && timestamp != TIMESTAMP_MAX)
+        return TraceFormat::TIMED;
+
+    return TraceFormat::TEXT;
+}
+
+std::uint64_t TraceToolkit::WriteRange(std::string const& input, TraceFormat input_format, std::size_t begin, std::size_t end,
+                                       std::uint64_t first_index, std::string const& output, TraceFormat format) const
+{
+    TraceReader reader(input);
+
+    if (input_format == format)
+    {
+        // Same format: copy the bytes.
+        std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+            throw std::runtime_error("Could not write to output file " + output);
+
+        if (format == TraceFormat::BINARY)
+            stream.write(reader.GetData(), sizeof(trace_format::Header));
+
+        if (!stream.write(reader.GetData() + begin, end - begin) || !stream.flush())
+            throw std::runtime_error("Could not write to output file " + output);
+
+        return reader.CountLines(begin, end);
+    }
+
+    // Every worker converts a chunk of lines into its own part.
+    std::vector<std::size_t> const chunks = reader.GetSliceOffsets(c_thread_count, begin, end);
+    std::size_t const chunk_count = chunks.size() - 1;
+    std::vector<std::uint64_t> first_indices(chunk_count, first_index);
+    std::vector<std::uint64_t> written(chunk_count, 0);
+
+    ThreadPool pool(c_thread_count, /* Pin */ false);
+    std::vector<ThreadPool::Task> tasks;
+
+    // Stamping accesses with their position needs the amount of lines before each chunk.
+    if (input_format == TraceFormat::TEXT && format != TraceFormat::TEXT)
+    {
+        std::vector<std::uint64_t> counts(chunk_count);
+
+        for (std::size_t i = 0; i < chunk_count; ++i)
+            tasks.push_back([&, i](unsigned) { counts[i] = reader.CountLines(chunks[i], chunks[i + 1]); });
+
+        pool.Run(std::move(tasks));
+        tasks.clear();
+
+        for (std::size_t i = 1; i < chunk_count; ++i)
+            first_indices[i] = first_indices[i - 1] + counts[i - 1];
+    }
+
+    for (std::size_t i = 0; i < chunk_count; ++i)
+    {
+        tasks.push_back([&, i](unsigned)
+        {
+            TraceReader chunk_reader(input);
+            chunk_reader.SetRange(chunks[i], chunks[i + 1]);
+            TraceEngine trace_engine(PartFile(output, i), /* Quiet */ true, format);
+
+            std::uint64_t index = first_indices[i];
+            Operation operation;
+            address_t address;
+            timestamp_t timestamp;
+
+            while (chunk_reader.GetNextTimedAccess(operation, address, timestamp))
+                trace_engine.Send({operation, address, timestamp == TIMESTAMP_MAX ? index++ : (++index, timestamp)});
+
+            written[i] = index - first_indices[i];
+            trace_engine.Shutdown();
+        });
+    }
+
+    try
+    {
+        pool.Run(std::move(tasks));
+        ConcatenateParts(output, chunk_count, format);
+    }
+    catch (...)
+    {
+        RemoveParts(output, chunk_count);
+        throw;
+    }
+
+    std::uint64_t total = 0;
+    for (std::uint64_t const count : written)
+        total += count;
+
+    return total;
+}
+
+std::vector<std::string> TraceToolkit::Split(std::string const& input, std::string const& prefix, std::uint64_t accesses, std::uint64_t bytes, TraceFormat format) const
+{
+    if ((accesses == 0) == (bytes == 0))
+        throw std::invalid_argument("Split needs either an amount of accesses or of bytes per part.");
+
+    TraceFormat const input_format = DetectFormat(input);
+    TraceReader reader(input);
+
+    // Part boundaries, at line starts, and the position of their first access.
+    std::vector<std::size_t> boundaries = {reader.GetDataBegin()};
+    std::vector<std::uint64_t> first_indices = {0};
+
+    while (boundaries.back() < reader.GetFileSize())
+    {
+        std::size_t const begin = boundaries.back();
+
+        if (accesses != 0)
+        {
+            boundaries.push_back(reader.AdvanceLines(begin, accesses));
+            first_indices.push_back(first_indices.back() + accesses);
+        }
+        else
+        {
+            // Cut after the line that crosses the byte budget. Binary parts hold whole records, at least one.
+            if (input_format == TraceFormat::BINARY)
+                boundaries.push_back(reader.AdvanceLines(begin, std::max<std::uint64_t>(1, bytes / sizeof(trace_format::Record))));
+            else
+                boundaries.push_back(reader.AdvanceLines(std::min<std::size_t>(reader.GetFileSize() - 1, begin + bytes - 1), 1));
+
+            first_indices.push_back(first_indices.back() + reader.CountLines(begin, boundaries.back()));
+        }
+    }
+
+    std::vector<std::string> parts;
+    int const digits = std::max<int>(4, static_cast<int>(std::to_string(boundaries.size()).size()));
+
+    for (std::size_t i = 0; i + 1 < boundaries.size(); ++i)
+    {
+        std::ostringstream name;
+        name << prefix << '_' << std::setw(digits) << std::setfill('0') << i << ".trace";
+
+        WriteRange(input, input_format, boundaries[i], boundaries[i + 1], first_indices[i], name.str(), format);
+        parts.push_back(name.str());
+    }
+
+    return parts;
+}
+
+std::uint64_t TraceToolkit::Merge(std::vector<std::string> const& inputs, std::string const& output, MergeOrder order, std::uint64_t quantum, TraceFormat format) const
+{
+    if (inputs.empty())
+        throw std::invalid_argument("Merge needs at least one input.");
+
+    if (order == MergeOrder::ROUND_ROBIN && quantum == 0)
+        throw std::invalid_argument("The round-robin quantum must be at least one access.");
+
+    std::vector<std::unique_ptr<TraceReader>> readers;
+    for (std::string const& input : inputs)
+        readers.push_back(std::make_unique<TraceReader>(input));
+
+    TraceEngine trace_engine(output, /* Quiet */ true, format);
+    std::uint64_t written = 0;
+
+    Operation operation;
+    address_t address;
+    timestamp_t timestamp;
+
+    if (order == MergeOrder::TIMESTAMP)
+    {
+        // Next access of every input, ordered by timestamp and then by input.
+        struct Pending
+        {
+            timestamp_t m_timestamp;
+            std::size_t m_input;
+            Operation m_operation;
+            address_t m_address;
+
+            bool operator>(Pending const& other) const
+            {
+                return m_timestamp != other.m_timestamp ? m_timestamp > other.m_timestamp : m_input > other.m_input;
+            }
+        };
+
+        std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending;
+
+        auto const fetch = [&](std::size_t const input)
+        {
+            if (!readers[input]->GetNextTimedAccess(operation, address, timestamp))
+                return;
+
+            if (timestamp == TIMESTAMP_MAX)
+                throw std::invalid_argument("Input " + inputs[input] + " has no timestamps. Merge it round-robin instead.");
+
+            pending.push({timestamp, input, operation, address});
+        };
+
+        for (std::size_t input = 0; input < readers.size(); ++input)
+            fetch(input);
+
+        while (!pending.empty())
+        {
+            Pending const next = pending.top();
+            pending.pop();
+
+            trace_engine.Send({next.m_operation, next.m_address, next.m_timestamp});
+            ++written;
+
+            fetch(next.m_input);
+        }
+    }
+    else
+    {
+        // Take a quantum from every input in turn until all are exhausted.
+        std::vector<bool> exhausted(readers.size(), false);
+        std::size_t remaining = readers.size();
+
+        while (remaining != 0)
+        {
+            for (std::size_t input = 0; input < readers.size(); ++input)
+            {
+                for (std::uint64_t i = 0; i < quantum && !exhausted[input]; ++i)
+                {
+                    if (!readers[input]->GetNextTimedAccess(operation, address, timestamp))
+                    {
+                        exhausted[input] = true;
+                        --remaining;
+                        break;
+                    }
+
+                    // Accesses without a timestamp are stamped with their position in the output.
+                    trace_engine.Send({operation, address, timestamp == TIMESTAMP_MAX ? written : timestamp});
+                    ++written;
+                }
+            }
+        }
+    }
+
+    trace_engine.Shutdown();
+    return written;
+}
+
+std::uint64_t TraceToolkit::Convert(std::string const& input, std::string const& output, TraceFormat format) const
+{
+    TraceReader reader(input);
+    return WriteRange(input, DetectFormat(input), reader.GetDataBegin(), reader.GetFileSize(), 0, output, format);
+}
+
+std::uint64_t TraceToolkit::Head(std::string const& input, std::string const& output, std::uint64_t accesses, TraceFormat format) const
+{
+    TraceReader reader(input);
+    std::size_t const end = reader.AdvanceLines(reader.GetDataBegin(), accesses);
+
+    if (!output.empty())
+        return WriteRange(input, DetectFormat(input), reader.GetDataBegin(), end, 0, output, format);
+
+    // Print as text, keeping the timestamps.
+    reader.SetRange(reader.GetDataBegin(), end);
+
+    std::uint64_t written = 0;
+    Operation operation;
+    address_t address;
+    timestamp_t timestamp;
+
+    while (reader.GetNextTimedAccess(operation, address, timestamp))
+    {
+        if (operation == FLUSH)
+            std::cout << "FLUSH";
+        else
+            std::cout << (operation == STORE ? "ST 0x" : "LD 0x") << std::hex << address << std::dec;
+
+        if (timestamp != TIMESTAMP_MAX)
+            std::cout << ' ' << timestamp;
+
+        std::cout << '\n';
+        ++written;
+    }
+
+    std::cout.flush();
+    return written;
+}
+
+TraceStats TraceToolkit::Stats(std::string const& input, std::uint64_t line_size, std::uint64_t page_size) const
+{
+    unsigned const line_shift = CheckedShift(line_size, "The line size");
+    unsigned const page_shift = CheckedShift(page_size, "The page size");
+
+    // Summary of one chunk of the trace.
+    struct Partial
+    {
+        TraceStats m_stats;
+        std::unordered_set<address_t> m_lines;
+        std::unordered_set<address_t> m_pages;
+        address_t m_first_line = 0;
+        address_t m_last_line = 0;
+        bool m_empty = true;
+    };
+
+    TraceReader reader(input);
+    std::vector<std::size_t> const chunks = reader.GetSliceOffsets(c_thread_count);
+    std::vector<Partial> partials(chunks.size() - 1);
+    std::vector<ThreadPool::Task> tasks;
+
+    for (std::size_t i = 0; i < partials.size(); ++i)
+    {
+        tasks.push_back([&, i](unsigned)
+        {
+            Partial& partial = partials[i];
+            TraceStats& stats = partial.m_stats;
+
+            TraceReader chunk_reader(input);
+            chunk_reader.SetRange(chunks[i], chunks[i + 1]);
+
+            Operation operation;
+            address_t address;
+
+            while (chunk_reader.GetNextAccess(operation, address))
+            {
+                if (operation == FLUSH)
+                {
+                    ++stats.m_flushes;
+                    continue;
+                }
+
+                ++(operation == STORE ? stats.m_stores : stats.m_loads);
+                stats.m_min_address = std::min(stats.m_min_address, address);
+                stats.m_max_address = std::max(stats.m_max_address, address);
+
+                address_t const line = address >> line_shift;
+                partial.m_lines.insert(line);
+                partial.m_pages.insert(address >> page_shift);
+
+                if (partial.m_empty)
+                {
+                    partial.m_first_line = line;
+                    partial.m_empty = false;
+                }
+                else if (line >= partial.m_last_line)
+                    ++stats.m_forward_strides[StrideBucket(line - partial.m_last_line)];
+                else
+                    ++stats.m_backward_strides[StrideBucket(partial.m_last_line - line)];
+
+                partial.m_last_line = line;
+            }
+        });
+    }
+
+    ThreadPool pool(c_thread_count, /* Pin */ false);
+    pool.Run(std::move(tasks));
+
+    // Reduce the chunks, adding the strides across their boundaries.
+    TraceStats total;
+    Partial* previous = nullptr;
+
+    for (Partial& partial : partials)
+    {
+        TraceStats const& stats = partial.m_stats;
+
+        total.m_loads += stats.m_loads;
+        total.m_stores += stats.m_stores;
+        total.m_flushes += stats.m_flushes;
+        total.m_min_address = std::min(total.m_min_address, stats.m_min_address);
+        total.m_max_address = std::max(total.m_max_address, stats.m_max_address);
+
+        for (std::size_t bucket = 0; bucket < TraceStats::c_stride_buckets; ++bucket)
+        {
+            total.m_forward_strides[bucket] += stats.m_forward_strides[bucket];
+            total.m_backward_strides[bucket] += stats.m_backward_strides[bucket];
+        }
+
+        if (partial.m_empty)
+            continue;
+
+        if (previous)
+        {
+            if (partial.m_first_line >= previous->m_last_line)
+                ++total.m_forward_strides[StrideBucket(partial.m_first_line - previous->m_last_line)];
+            else
+                ++total.m_backward_strides[StrideBucket(previous->m_last_line - partial.m_first_line)];
+        }
+
+        previous = &partial;
+    }
+
+    // Merge the footprints into the largest set.
+    auto const merge = [&](auto member) -> std::uint64_t
+    {
+        Partial& largest = *std::max_element(partials.begin(), partials.end(), [&](Partial const& a, Partial const& b) { return (a.*member).size() < (b.*member).size(); });
+
+        for (Partial& partial : partials)
+            if (&partial != &largest)
+                (largest.*member).insert((partial.*member).begin(), (partial.*member).end());
+
+        return (largest.*member).size();
+    };
+
+    total.m_footprint_lines = merge(&Partial::m_lines);
+    total.m_footprint_pages = merge(&Partial::m_pages);
+
+    return total;
+}
+
+void TraceToolkit::PrintStats(std::ostream& stream, TraceStats const& stats, std::uint64_t line_size, std::uint64_t page_size)
+{
+    std::ios::fmtflags const flags = stream.flags();
+
+    std::uint64_t const accesses = stats.m_loads + stats.m_stores;
+    std::uint64_t const strides = accesses > 0 ? accesses - 1 : 0;
+    auto const percent = [](std::uint64_t part, std::uint64_t whole) { return whole > 0 ? 100.0 * part / whole : 0.0; };
+
+    stream << std::fixed << std::setprecision(2);
+    stream << "Trace Statistics:" << std::endl;
+    stream << "    Accesses:        " << accesses << std::endl;
+    stream << "    Loads:           " << stats.m_loads << " (" << percent(stats.m_loads, accesses) << " %)" << std::endl;
+    stream << "    Stores:          " << stats.m_stores << " (" << percent(stats.m_stores, accesses) << " %)" << std::endl;
+    if (stats.m_flushes != 0)
+        stream << "    Flush points:    " << stats.m_flushes << std::endl;
+    stream << "    Footprint:       " << stats.m_footprint_lines << " lines of " << line_size << " B ("
+           << static_cast<double>(stats.m_footprint_lines * line_size) / (1 << 20) << " MiB)" << std::endl;
+    stream << "    Pages:           " << stats.m_footprint_pages << " pages of " << page_size << " B ("
+           << static_cast<double>(stats.m_footprint_pages * page_size) / (1 << 20) << " MiB)" << std::endl;
+
+    if (accesses != 0)
+        stream << "    Address range:   0x" << std::hex << stats.m_min_address << " - 0x" << stats.m_max_address << std::dec << std::endl;
+
+    if (strides == 0)
+    {
+        stream.flags(flags);
+        return;
+    }
+
+    // Label of a bucket: the range of line distances it holds, in increasing order (-3..-2, +2..3).
+    auto const label = [](char sign, std::size_t bucket) -> std::string
+    {
+        if (bucket == 0)
+            return "0";
+
+        std::uint64_t const low = std::uint64_t(1) << (bucket - 1);
+        std::uint64_t const high = bucket == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bucket) - 1;
+
+        if (low == high)
+            return std::string(1, sign) + std::to_string(low);
+
+        if (sign == '-')
+            return "-" + std::to_string(high) + "..-" + std::to_string(low);
+
+        return std::string(1, sign) + std::to_string(low) + ".." + std::to_string(high);
+    };
+
+    auto const print = [&](std::string const& name, std::uint64_t count)
+    {
+        if (count != 0)
+            stream << "        " << std::left << std::setw(24) << name << std::right << std::setw(12) << count << "  (" << std::setw(6) << percent(count, strides) << " %)" << std::endl;
+    };
+
+    stream << "    Strides (lines between consecutive accesses):" << std::endl;
+
+    for (std::size_t bucket = TraceStats::c_stride_buckets - 1; bucket > 0; --bucket)
+        print(label('-', bucket), stats.m_backward_strides[bucket]);
+
+    print(label('+', 0), stats.m_forward_strides[0]);
+
+    for (std::size_t bucket = 1; bucket < TraceStats::c_stride_buckets; ++bucket)
+        print(label('+', bucket), stats.m_forward_strides[bucket]);
+
+    stream.flags(flags);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file      write_combining_buffer.cpp
+ * @brief     Write-combining buffer class implementation.
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/write_combining_buffer.h>
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+WriteCombiningBuffer::WriteCombiningBuffer(std::size_t entries, MemorySink& target) :
+        m_target(target),
+        c_capacity(entries),
+        m_entries(entries),
+        m_oldest(0),
+        m_count(0),
+        m_received{0, 0},
+        m_merged_stores(0),
+        m_forwarded_loads(0),
+        m_merged_loads(0),
+        m_forwarded(0)
+{
+    if (entries == 0)
+        throw std::invalid_argument("Write-combining buffer must hold at least one entry.");
+}
+
+void WriteCombiningBuffer::Send(MemoryRequest const& request)
+{
+    // Flush points order everything before them.
+    if (request.m_operation == FLUSH)
+    {
+        Drain();
+        m_target.Send(request);
+        return;
+    }
+
+    ++m_received[request.m_operation];
+
+    // Newest buffered request to the same line, searched from the newest entry back.
+    std::size_t index = (m_oldest + m_count) % c_capacity;
+
+    for (std::size_t i = 0; i < m_count; ++i)
+    {
+        index = (index == 0 ? c_capacity : index) - 1;
+        MemoryRequest const& entry = m_entries[index];
+
+        if (entry.m_address != request.m_address)
+            continue;
+
+        if (entry.m_operation == STORE)
+        {
+            // The line is in the buffer: a store merges, a fill is served from it.
+            ++(request.m_operation == STORE ? m_merged_stores : m_forwarded_loads);
+            return;
+        }
+
+        // A fill is pending: a second fill is redundant, a store must follow it.
+        if (request.m_operation == LOAD)
+        {
+            ++m_merged_loads;
+            return;
+        }
+
+        break;
+    }
+
+    if (m_count == c_capacity)
+        Evict();
+
+    m_entries[(m_oldest + m_count) % c_capacity] = request;
+    ++m_count;
+}
+
+void WriteCombiningBuffer::Evict()
+{
+    m_target.Send(m_entries[m_oldest]);
+    ++m_forwarded;
+
+    m_oldest = (m_oldest + 1) % c_capacity;
+    --m_count;
+}
+
+void WriteCombiningBuffer::Drain()
+{
+    while (m_count != 0)
+        Evict();
+}
+
+void WriteCombiningBuffer::PrintStatistics(std::ostream& stream) const
+{
+    std::ios::fmtflags const flags = stream.flags();
+    std::uint64_t const received = m_received[LOAD] + m_received[STORE];
+
+    stream << std::endl;
+    stream << "Write Combining:" << std::endl;
+    stream << "    Entries:         " << c_capacity << std::endl;
+    stream << "    Received:        " << received << " (" << m_received[LOAD] << " fills, " << m_received[STORE] << " stores)" << std::endl;
+    stream << "    Merged stores:   " << m_merged_stores << std::endl;
+    stream << "    Forwarded fills: " << m_forwarded_loads << std::endl;
+    stream << "    Merged fills:    " << m_merged_loads << std::endl;
+    stream << std::fixed << std::setprecision(2);
+    stream << "    Sent to memory:  " << m_forwarded + m_count << " (" << (received ? 100.0 * (m_forwarded + m_count) / received : 0.0) << " %)" << std::endl;
+
+    stream.flags(flags);
+}
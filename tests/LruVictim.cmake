@@ -0,0 +1,43 @@
+# ==============================================================================
+# Project:     TBridge
+# Author:      Victor Jimenez (victor.jimenez@colorado.edu)
+# Institution: Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+# Date:        2026-10-19
+# ==============================================================================
+#
+# Regression test: a full set evicts its least recently used line, not its last way.
+#
+# One 4-way set is filled with A (dirty), B, C and D, then D, C and B are accessed again. A is the LRU line: the
+# miss on E must write it back and take its way, and the following access to D must hit.
+
+cmake_minimum_required(VERSION 3.10)
+
+foreach(variable TBRIDGE WORK_DIR)
+    if(NOT ${variable})
+        message(FATAL_ERROR "${variable} is not set; run this test through ctest.")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+file(WRITE ${WORK_DIR}/input.trace
+    "ST 0x1000\nLD 0x1040\nLD 0x1080\nLD 0x10c0\n"
+    "LD 0x10c0\nLD 0x1080\nLD 0x1040\n"
+    "LD 0x1100\nLD 0x10c0\n")
+
+file(WRITE ${WORK_DIR}/test.conf
+    "[CACHE]\nsets = 1\nways = 4\nline_size = 64\n\n"
+    "[IO]\ninput_trace_file = \"${WORK_DIR}/input.trace\"\noutput_trace_file = \"${WORK_DIR}/output.trace\"\n")
+
+execute_process(COMMAND ${TBRIDGE} -f ${WORK_DIR}/test.conf RESULT_VARIABLE result OUTPUT_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "The simulator failed (${result}).")
+endif()
+
+file(READ ${WORK_DIR}/output.trace output)
+set(expected "LD 0x1000\nLD 0x1040\nLD 0x1080\nLD 0x10c0\nST 0x1000\nLD 0x1100\n")
+
+if(NOT output STREQUAL expected)
+    message(FATAL_ERROR "Unexpected output trace.\nExpected:\n${expected}\nGot:\n${output}")
+endif()
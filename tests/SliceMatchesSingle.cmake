@@ -0,0 +1,62 @@
+# ==============================================================================
+# Project:     TBridge
+# Author:      Victor Jimenez (victor.jimenez@colorado.edu)
+# Institution: Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+# Date:        2026-10-19
+# ==============================================================================
+#
+# Regression test: a time-sliced run with one slice and no warmup writes the same output as a single run of the
+# same configuration. The slice sees the whole trace on a cold cache and flushes it, as the exact run does.
+#
+# Each case adds sections to a small cache configuration that evicts on a generated trace.
+
+cmake_minimum_required(VERSION 3.10)
+
+foreach(variable TBRIDGE TRACEGEN WORK_DIR)
+    if(NOT ${variable})
+        message(FATAL_ERROR "${variable} is not set; run this test through ctest.")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+set(trace ${WORK_DIR}/input.trace)
+execute_process(COMMAND ${TRACEGEN} -o ${trace} --accesses 20000 --pattern random --footprint 256K --write-ratio 0.5
+    RESULT_VARIABLE result OUTPUT_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "The trace generator failed (${result}).")
+endif()
+
+set(plain_sections "")
+set(write_combining_sections "[WRITE_COMBINING]\nenabled = true\nentries = 8\n")
+set(cases plain write_combining)
+
+foreach(case ${cases})
+    set(case_dir ${WORK_DIR}/${case})
+    file(MAKE_DIRECTORY ${case_dir})
+
+    foreach(run single slice)
+        file(WRITE ${case_dir}/${run}.conf
+            "[CACHE]\nsets = 16\nways = 4\nline_size = 64\n\n"
+            "${${case}_sections}\n"
+            "[IO]\ninput_trace_file = \"${trace}\"\noutput_trace_file = \"${case_dir}/${run}.trace\"\n")
+    endforeach()
+
+    execute_process(COMMAND ${TBRIDGE} -f ${case_dir}/single.conf RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "The single run of ${case} failed (${result}).")
+    endif()
+
+    execute_process(COMMAND ${TBRIDGE} -f ${case_dir}/slice.conf --slices 1 --warmup 0 --jobs 1 RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "The sliced run of ${case} failed (${result}).")
+    endif()
+
+    file(SHA256 ${case_dir}/single.trace single_hash)
+    file(SHA256 ${case_dir}/slice.trace slice_hash)
+
+    if(NOT single_hash STREQUAL slice_hash)
+        message(FATAL_ERROR "The sliced and single runs of ${case} differ: compare ${case_dir}/single.trace and ${case_dir}/slice.trace.")
+    endif()
+endforeach()
@@ -0,0 +1,62 @@
+# ==============================================================================
+# Project:     TBridge
+# Author:      Victor Jimenez (victor.jimenez@colorado.edu)
+# Institution: Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+# Date:        2026-10-19
+# ==============================================================================
+#
+# Regression test: a time-sliced run with the trace issue timing completes, and its timed output keeps the cycles
+# in order across the slice boundary.
+#
+# Each slice but the last destroys its cache unflushed, which flushes through the issue timing: the timing state
+# must still be alive then. Build with -fsanitize=address to catch a use after free that does not crash.
+
+cmake_minimum_required(VERSION 3.10)
+
+foreach(variable TBRIDGE TRACEGEN TOOLS WORK_DIR)
+    if(NOT ${variable})
+        message(FATAL_ERROR "${variable} is not set; run this test through ctest.")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+# Converting a text trace to timed stamps each access with its position.
+execute_process(COMMAND ${TRACEGEN} -o ${WORK_DIR}/input.trace --accesses 4000 --pattern random --footprint 256K --write-ratio 0.5
+    RESULT_VARIABLE result OUTPUT_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "The trace generator failed (${result}).")
+endif()
+
+execute_process(COMMAND ${TOOLS} convert ${WORK_DIR}/input.trace -o ${WORK_DIR}/timed.trace --to timed
+    RESULT_VARIABLE result OUTPUT_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "The conversion to timed failed (${result}).")
+endif()
+
+file(WRITE ${WORK_DIR}/test.conf
+    "[CACHE]\nsets = 16\nways = 4\nline_size = 64\n\n"
+    "[TIMING]\nmode = \"trace\"\n\n"
+    "[IO]\ninput_trace_file = \"${WORK_DIR}/timed.trace\"\noutput_trace_file = \"${WORK_DIR}/output.trace\"\n"
+    "output_trace_format = \"timed\"\n")
+
+execute_process(COMMAND ${TBRIDGE} -f ${WORK_DIR}/test.conf --slices 2 --warmup 1000 RESULT_VARIABLE result OUTPUT_QUIET)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "The sliced run failed (${result}).")
+endif()
+
+file(STRINGS ${WORK_DIR}/output.trace lines)
+list(LENGTH lines line_count)
+if(line_count EQUAL 0)
+    message(FATAL_ERROR "The output trace is empty.")
+endif()
+
+set(previous 0)
+foreach(line ${lines})
+    string(REGEX REPLACE "^.* " "" cycle "${line}")
+    if(cycle LESS previous)
+        message(FATAL_ERROR "The cycles go backwards at \"${line}\" (previous cycle ${previous}).")
+    endif()
+    set(previous ${cycle})
+endforeach()
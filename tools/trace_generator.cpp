@@ -0,0 +1,210 @@
+/**
+ * @file      trace_generator.cpp
+ * @brief     Command-line front end of the synthetic trace generator (tbridge_tracegen).
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/shm_ring.h>
+#include <utils/trace_generator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout << SIMULATOR_NAME << " v" << SIMULATOR_VERSION << " trace generator" << std::endl
+                  << "Usage: tbridge_tracegen (-o <file> | --shm <name>) [options]" << std::endl
+                  << "Options: " << std::endl
+                  << "  -o, --output <file>     Output trace file" << std::endl
+                  << "  --shm <name>            Stream the accesses to the shared-memory ring of a running T-Bridge instead" << std::endl
+                  << "  --pattern <name>        streaming, strided, random, zipfian or pointer_chase (Default: streaming)" << std::endl
+                  << "  --phases <list>         Mixed workload, e.g. zipfian:1M,streaming:200K (overrides --pattern)" << std::endl
+                  << "  --accesses <n>          Amount of accesses (Default: 1M)" << std::endl
+                  << "  --footprint <bytes>     Bytes touched by the workload (Default: 64M)" << std::endl
+                  << "  --write-ratio <r>       Fraction of stores in [0, 1] (Default: 0.3)" << std::endl
+                  << "  --seed <n>              Random seed (Default: 1)" << std::endl
+                  << "  --stride <bytes>        Stride of the strided pattern (Default: 256)" << std::endl
+                  << "  --element-size <bytes>  Access size of the streaming pattern (Default: 8)" << std::endl
+                  << "  --line-size <bytes>     Line size of the line-granular patterns (Default: 64)" << std::endl
+                  << "  --zipf-theta <t>        Zipfian skew in (0, 1) (Default: 0.99)" << std::endl
+                  << "  --base <address>        First address of the footprint (Default: 0x7f0000000000)" << std::endl
+                  << "  --digits <n>            Hexadecimal digits per address (Default: 12)" << std::endl
+                  << "  --threads <n>           Writer threads (Default: all hardware threads)" << std::endl
+                  << "  -h, --help              Show this help message" << std::endl
+                  << "Counts and sizes accept K, M and G suffixes (powers of 1024)." << std::endl;
+    }
+
+    // Parse a number with an optional K/M/G suffix. Accepts hexadecimal with a 0x prefix.
+    std::uint64_t ParseSize(std::string const& text)
+    {
+        std::size_t end = 0;
+        std::uint64_t value = std::stoull(text, &end, 0);
+
+        if (end < text.size())
+        {
+            switch (text[end])
+            {
+                case 'k': case 'K': value <<= 10; break;
+                case 'm': case 'M': value <<= 20; break;
+                case 'g': case 'G': value <<= 30; break;
+                default:
+                    throw std::invalid_argument("Invalid size '" + text + "'.");
+            }
+
+            if (end + 1 != text.size())
+                throw std::invalid_argument("Invalid size '" + text + "'.");
+        }
+
+        return value;
+    }
+
+    // Parse a comma separated list of pattern:length phases.
+    std::vector<GeneratorPhase> ParsePhases(std::string const& text)
+    {
+        std::vector<GeneratorPhase> phases;
+        std::size_t start = 0;
+
+        while (start < text.size())
+        {
+            std::size_t end = text.find(',', start);
+            if (end == std::string::npos)
+                end = text.size();
+
+            std::string const phase = text.substr(start, end - start);
+            std::size_t const colon = phase.find(':');
+            if (colon == std::string::npos)
+                throw std::invalid_argument("Invalid phase '" + phase + "'. Expected <pattern>:<length>.");
+
+            phases.push_back({TraceGenerator::ParsePattern(phase.substr(0, colon)), ParseSize(phase.substr(colon + 1))});
+            start = end + 1;
+        }
+
+        return phases;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    GeneratorConfig config;
+    std::string output_file;
+    std::string shm_name;
+    std::string pattern = "streaming";
+    std::string phases;
+
+    // Parse command-line arguments.
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const argument = argv[i];
+
+        // Fetch the value of an option that requires one.
+        auto next_value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("The " + argument + " option requires an argument.");
+
+            return argv[++i];
+        };
+
+        if (argument == "-h" || argument == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (argument == "-o" || argument == "--output")
+            output_file = next_value();
+        else if (argument == "--shm")
+            shm_name = next_value();
+        else if (argument == "--pattern")
+            pattern = next_value();
+        else if (argument == "--phases")
+            phases = next_value();
+        else if (argument == "--accesses")
+            config.m_accesses = ParseSize(next_value());
+        else if (argument == "--footprint")
+            config.m_footprint = ParseSize(next_value());
+        else if (argument == "--write-ratio")
+            config.m_write_ratio = std::stod(next_value());
+        else if (argument == "--seed")
+            config.m_seed = std::stoull(next_value(), nullptr, 0);
+        else if (argument == "--stride")
+            config.m_stride = ParseSize(next_value());
+        else if (argument == "--element-size")
+            config.m_element_size = ParseSize(next_value());
+        else if (argument == "--line-size")
+            config.m_line_size = ParseSize(next_value());
+        else if (argument == "--zipf-theta")
+            config.m_zipf_theta = std::stod(next_value());
+        else if (argument == "--base")
+            config.m_base_address = std::stoull(next_value(), nullptr, 0);
+        else if (argument == "--digits")
+            config.m_address_digits = static_cast<unsigned>(std::stoul(next_value()));
+        else if (argument == "--threads")
+            config.m_threads = static_cast<unsigned>(std::stoul(next_value()));
+        else
+        {
+            std::cerr << "Error: Unknown option '" << argument << "'." << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (output_file.empty() == shm_name.empty())
+    {
+        std::cerr << "Error: Either an output file or a shared-memory ring is required." << std::endl;
+        PrintUsage();
+        return 1;
+    }
+
+    // A single phase as long as the whole trace is a pure pattern.
+    if (phases.empty())
+        config.m_phases = {{TraceGenerator::ParsePattern(pattern), std::max<std::uint64_t>(1, config.m_accesses)}};
+    else
+        config.m_phases = ParsePhases(phases);
+
+    TraceGenerator generator(config);
+
+    if (!shm_name.empty())
+    {
+        // Act as a live tracer: a single writer keeps the order of the file output.
+        ShmRingProducer producer(shm_name);
+        ShmRingWriter writer(producer);
+
+        auto const start = std::chrono::steady_clock::now();
+        Operation operation;
+        address_t address;
+
+        for (std::uint64_t i = 0; i < config.m_accesses; ++i)
+        {
+            generator.GetAccess(i, operation, address);
+            writer.Write(operation == STORE, address);
+        }
+
+        writer.Close();
+        producer.Finish();
+
+        double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Streamed " << config.m_accesses << " accesses to " << shm_name << " in " << seconds << " s ("
+                  << (seconds > 0 ? static_cast<double>(config.m_accesses) / seconds / 1e6 : 0.0) << " M accesses/s)" << std::endl;
+
+        return 0;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    std::uint64_t const bytes = generator.Write(output_file);
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Generated " << config.m_accesses << " accesses (" << bytes << " bytes) to " << output_file
+              << " in " << seconds << " s (" << (seconds > 0 ? static_cast<double>(bytes) / seconds / 1e9 : 0.0) << " GB/s)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file      trace_toolkit.cpp
+ * @brief     Command-line front end of the trace toolkit (tbridge_tools).
+ * @author    Victor Jimenez (victor.jimenez@colorado.edu)
+ * @date      2026-10-18
+ *
+ * Boulder Computer Architecture Research Lab, University of Colorado Boulder, Colorado, USA
+ *
+ * If you use this code for your research, please cite:
+ * Victor Jimenez, "Unpublished Research", 2025.
+ */
+
+#include <utils/trace_toolkit.h>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout << SIMULATOR_NAME << " v" << SIMULATOR_VERSION << " trace toolkit" << std::endl
+                  << "Usage: tbridge_tools <command> [options]" << std::endl
+                  << "Commands: " << std::endl
+                  << "  split <input> --prefix <p> (--accesses <n> | --bytes <n>)   Cut a trace into <p>_<index>.trace parts" << std::endl
+                  << "  merge <inputs...> -o <file> [--by timestamp|round-robin] [--quantum <n>]" << std::endl
+                  << "                                                             Interleave traces (Default: by timestamp)" << std::endl
+                  << "  convert <input> -o <file> --to <format>                    Rewrite a trace in another format" << std::endl
+                  << "  head <input> [-n <n>] [-o <file>]                          Copy the first accesses (Default: 10, to stdout)" << std::endl
+                  << "  stats <input> [--line-size <bytes>] [--page-size <bytes>]   Operation mix, footprint and stride histogram" << std::endl
+                  << "Options: " << std::endl
+                  << "  --format <format>       Output format of split, merge and head: text, timed, binary, dramsim3 or dramsys (Default: the input's)" << std::endl
+                  << "  --threads <n>           Worker threads (Default: all allowed CPUs)" << std::endl
+                  << "  -h, --help              Show this help message" << std::endl
+                  << "Counts and sizes accept K, M and G suffixes (powers of 1024)." << std::endl;
+    }
+
+    // Parse a number with an optional K/M/G suffix. Accepts hexadecimal with a 0x prefix.
+    std::uint64_t ParseSize(std::string const& text)
+    {
+        std::size_t end = 0;
+        std::uint64_t value = std::stoull(text, &end, 0);
+
+        if (end < text.size())
+        {
+            switch (text[end])
+            {
+                case 'k': case 'K': value <<= 10; break;
+                case 'm': case 'M': value <<= 20; break;
+                case 'g': case 'G': value <<= 30; break;
+                default:
+                    throw std::invalid_argument("Invalid size '" + text + "'.");
+            }
+
+            if (end + 1 != text.size())
+                throw std::invalid_argument("Invalid size '" + text + "'.");
+        }
+
+        return value;
+    }
+
+    // Parse a merge order name.
+    MergeOrder ParseOrder(std::string const& name)
+    {
+        if (name == "timestamp")
+            return MergeOrder::TIMESTAMP;
+        if (name == "round-robin")
+            return MergeOrder::ROUND_ROBIN;
+
+        throw std::invalid_argument("Unknown merge order '" + name + "'. Expected timestamp or round-robin.");
+    }
+
+    int Run(int argc, char* argv[])
+    {
+        if (argc < 2)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        std::string const command = argv[1];
+        if (command == "-h" || command == "--help")
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        std::vector<std::string> inputs;
+        std::string output_file;
+        std::string prefix;
+        std::string format;
+        std::uint64_t accesses = 0;
+        std::uint64_t bytes = 0;
+        std::uint64_t head_accesses = 10;
+        std::uint64_t quantum = 1;
+        std::uint64_t line_size = 64;
+        std::uint64_t page_size = 4096;
+        MergeOrder order = MergeOrder::TIMESTAMP;
+        unsigned threads = 0;
+
+        // Parse command-line arguments.
+        for (int i = 2; i < argc; ++i)
+        {
+            std::string const argument = argv[i];
+
+            // Fetch the value of an option that requires one.
+            auto next_value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("The " + argument + " option requires an argument.");
+
+                return argv[++i];
+            };
+
+            if (argument == "-h" || argument == "--help")
+            {
+                PrintUsage();
+                return 0;
+            }
+            else if (argument == "-o" || argument == "--output")
+                output_file = next_value();
+            else if (argument == "--prefix")
+                prefix = next_value();
+            else if (argument == "--accesses")
+                accesses = ParseSize(next_value());
+            else if (argument == "--bytes")
+                bytes = ParseSize(next_value());
+            else if (argument == "-n")
+                head_accesses = ParseSize(next_value());
+            else if (argument == "--by")
+                order = ParseOrder(next_value());
+            else if (argument == "--quantum")
+                quantum = ParseSize(next_value());
+            else if (argument == "--format" || argument == "--to")
+                format = next_value();
+            else if (argument == "--line-size")
+                line_size = ParseSize(next_value());
+            else if (argument == "--page-size")
+                page_size = ParseSize(next_value());
+            else if (argument == "--threads")
+                threads = static_cast<unsigned>(std::stoul(next_value()));
+            else if (!argument.empty() && argument[0] == '-')
+            {
+                std::cerr << "Error: Unknown option '" << argument << "'." << std::endl;
+                PrintUsage();
+                return 1;
+            }
+            else
+                inputs.push_back(argument);
+        }
+
+        if (inputs.empty() || (command != "merge" && inputs.size() != 1))
+            throw std::invalid_argument(command == "merge" ? "Merge needs at least one input trace." : "The " + command + " command takes exactly one input trace.");
+
+        TraceToolkit toolkit(threads);
+
+        // Output format: the requested one, or the one of the (first) input.
+        TraceFormat const output_format = format.empty() ? TraceToolkit::DetectFormat(inputs[0]) : trace_format::Parse(format);
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const seconds = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+        if (command == "split")
+        {
+            if (prefix.empty())
+                throw std::invalid_argument("Split needs an output prefix (--prefix).");
+
+            std::vector<std::string> const parts = toolkit.Split(inputs[0], prefix, accesses, bytes, output_format);
+            std::cout << "Split " << inputs[0] << " into " << parts.size() << " " << trace_format::Name(output_format) << " parts in " << seconds() << " s" << std::endl;
+        }
+        else if (command == "merge")
+        {
+            if (output_file.empty())
+                throw std::invalid_argument("Merge needs an output file (-o).");
+
+            std::uint64_t const written = toolkit.Merge(inputs, output_file, order, quantum, output_format);
+            std::cout << "Merged " << inputs.size() << " traces (" << written << " accesses) into " << output_file << " in " << seconds() << " s" << std::endl;
+        }
+        else if (command == "convert")
+        {
+            if (output_file.empty() || format.empty())
+                throw std::invalid_argument("Convert needs an output file (-o) and a format (--to).");
+
+            std::uint64_t const written = toolkit.Convert(inputs[0], output_file, output_format);
+            std::cout << "Converted " << written << " accesses to " << trace_format::Name(output_format) << " in " << output_file << " in " << seconds() << " s" << std::endl;
+        }
+        else if (command == "head")
+            toolkit.Head(inputs[0], output_file, head_accesses, output_format);
+        else if (command == "stats")
+            TraceToolkit::PrintStats(std::cout, toolkit.Stats(inputs[0], line_size, page_size), line_size, page_size);
+        else
+        {
+            std::cerr << "Error: Unknown command '" << command << "'." << std::endl;
+            PrintUsage();
+            return 1;
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        return Run(argc, argv);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}